@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Аллокатор, выравнивающий каждый буфер по границе Alignment байт.
+// Выравнивание 32 подходит для загрузок AVX2, 64 — по размеру кэш-линии,
+// чтобы буферы разных потоков не делили одну линию. Аллокатор не хранит
+// состояния, поэтому все его экземпляры равны и память, выделенная одним,
+// освобождается любым другим
+template <typename Type, size_t Alignment = 64>
+class AlignedAllocator {
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(Type),
+                  "Alignment must not be weaker than alignof(Type)");
+
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    static constexpr size_t kAlignment = Alignment;
+
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment>&) noexcept {
+    }
+
+    // Выделяет память под count элементов.
+    // Выбрасывает исключение std::bad_array_new_length, если размер не
+    // помещается в size_t, и std::bad_alloc, если памяти не хватило
+    [[nodiscard]] Type* allocate(size_t count) {
+        if (count > max_size()) {
+            throw std::bad_array_new_length();
+        }
+
+        return static_cast<Type*>(
+            ::operator new(count * sizeof(Type), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(Type* ptr, size_t count) noexcept {
+        ::operator delete(ptr, count * sizeof(Type), std::align_val_t(Alignment));
+    }
+
+    size_t max_size() const noexcept {
+        return std::numeric_limits<size_t>::max() / sizeof(Type);
+    }
+};
+
+template <typename Type, typename Other, size_t Alignment>
+bool operator==(const AlignedAllocator<Type, Alignment>&,
+                const AlignedAllocator<Other, Alignment>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other, size_t Alignment>
+bool operator!=(const AlignedAllocator<Type, Alignment>&,
+                const AlignedAllocator<Other, Alignment>&) noexcept {
+    return false;
+}
+
+namespace detail {
+
+template <typename Allocator, typename = void>
+struct AllocatorAlignment
+    : std::integral_constant<size_t, alignof(typename Allocator::value_type)> {};
+
+// Аллокатор, объявивший kAlignment, гарантирует выравнивание своих буферов
+template <typename Allocator>
+struct AllocatorAlignment<Allocator, std::void_t<decltype(Allocator::kAlignment)>>
+    : std::integral_constant<size_t, Allocator::kAlignment> {};
+
+template <typename Allocator>
+inline constexpr size_t kAllocatorAlignment = AllocatorAlignment<Allocator>::value;
+
+}  // namespace detail
@@ -1,48 +1,95 @@
 #pragma once
 
+#include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
-template <typename Type>
+#include "constexpr_support.h"
+
+namespace detail {
+
+template <typename Allocator, typename = void>
+struct HasTryExpand : std::false_type {};
+
+template <typename Allocator>
+struct HasTryExpand<
+    Allocator, std::void_t<decltype(std::declval<const Allocator&>().TryExpand(
+                   std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>>
+    : std::true_type {};
+
+// Аллокатор может увеличить выделенный буфер на месте, если определяет
+// bool TryExpand(pointer, old_size, new_size) (см. MmapAllocator)
+template <typename Allocator>
+inline constexpr bool kHasTryExpand = HasTryExpand<Allocator>::value;
+
+}  // namespace detail
+
+// Владеет неинициализированной памятью под size элементов типа Type,
+// полученной от аллокатора Allocator.
+// ArrayPtr не конструирует и не разрушает элементы: за время жизни объектов
+// в буфере отвечает владелец ArrayPtr
+template <typename Type, typename Allocator = std::allocator<Type>>
 class ArrayPtr {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
 public:
     // Инициализирует ArrayPtr нулевым указателем
     ArrayPtr() = default;
 
-    // Создаёт в куче массив из size элементов типа Type.
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(const Allocator& alloc) noexcept
+        : alloc_(alloc) {
+    }
+
+    // Выделяет неинициализированную память под size элементов типа Type.
     // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size) {
-        if (size == 0) {
-            raw_ptr_ = nullptr;
-        } else {
-            raw_ptr_ = new Type[size]{};
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(size_t size,
+                                              const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
+        if (size != 0) {
+            raw_ptr_ = AllocTraits::allocate(alloc_, size);
+            size_ = size;
         }
     }
 
-    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept {
-        raw_ptr_ = raw_ptr;
+    // Конструктор из сырого указателя на память под size элементов,
+    // выделенную аллокатором alloc, либо nullptr
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(Type* raw_ptr, size_t size,
+                                     const Allocator& alloc = Allocator()) noexcept
+        : alloc_(alloc), raw_ptr_(raw_ptr), size_(raw_ptr == nullptr ? 0 : size) {
     }
 
-    // Перемещающий конструктор
-    ArrayPtr(ArrayPtr&& moved) 
-        : raw_ptr_(moved.raw_ptr_) {
-        moved.raw_ptr_ = nullptr;
+    // Перемещающий конструктор. Аллокатор перемещается вместе с памятью
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(ArrayPtr&& moved) noexcept
+        : alloc_(std::move(moved.alloc_)),
+          raw_ptr_(std::exchange(moved.raw_ptr_, nullptr)),
+          size_(std::exchange(moved.size_, 0)) {
     }
 
-    ArrayPtr& operator=(ArrayPtr&& rhs) {
+    // Перемещающее присваивание. Аллокатор заменяется, только если этого
+    // требует propagate_on_container_move_assignment. Иначе аллокаторы
+    // должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr& operator=(ArrayPtr&& rhs) noexcept {
         if (this != &rhs) {
-            ArrayPtr temp(std::move(rhs));
-            swap(rhs);
+            Deallocate();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(rhs.alloc_);
+            } else {
+                assert(alloc_ == rhs.alloc_);
+            }
+            raw_ptr_ = std::exchange(rhs.raw_ptr_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
         }
-        
+
         return *this;
     }
 
     // Запрещаем копирование
     ArrayPtr(const ArrayPtr&) = delete;
 
-    ~ArrayPtr() {
-        delete[] raw_ptr_;
+    SIMPLE_VECTOR_CONSTEXPR ~ArrayPtr() {
+        Deallocate();
     }
 
     // Запрещаем присваивание
@@ -50,42 +97,88 @@ public:
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
     // После вызова метода указатель на массив должен обнулиться
-    [[nodiscard]] Type* Release() noexcept {
-        Type* to_return = raw_ptr_;
-        raw_ptr_ = nullptr;
-        
-        return to_return;
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR Type* Release() noexcept {
+        size_ = 0;
+        return std::exchange(raw_ptr_, nullptr);
     }
 
     // Возвращает ссылку на элемент массива с индексом index
-    Type& operator[](size_t index) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
         return *(raw_ptr_ + index);
     }
 
     // Возвращает константную ссылку на элемент массива с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
         return *(raw_ptr_ + index);
     }
 
     // Возвращает true, если указатель ненулевой, и false в противном случае
-    explicit operator bool() const {
-        if (raw_ptr_ ==  nullptr) {
-            return false;
-        }
-
-        return true;
+    SIMPLE_VECTOR_CONSTEXPR explicit operator bool() const {
+        return raw_ptr_ != nullptr;
     }
 
     // Возвращает значение сырого указателя, хранящего адрес начала массива
-    Type* Get() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type* Get() const noexcept {
         return raw_ptr_;
     }
 
-    // Обменивается значениям указателя на массив с объектом other
-    void swap(ArrayPtr& other) noexcept {
+    // Возвращает количество элементов, под которые выделена память
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Увеличивает буфер до new_size элементов без перевыделения, если это
+    // позволяет аллокатор. Возвращает false, если буфер остался прежним
+    SIMPLE_VECTOR_CONSTEXPR bool TryExpand(size_t new_size) noexcept {
+        if constexpr (detail::kHasTryExpand<Allocator>) {
+            if (raw_ptr_ != nullptr && new_size > size_ &&
+                alloc_.TryExpand(raw_ptr_, size_, new_size)) {
+                size_ = new_size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Возвращает аллокатор, которым выделена память
+    SIMPLE_VECTOR_CONSTEXPR Allocator& GetAllocator() noexcept {
+        return alloc_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Allocator& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Заменяет аллокатор пустого ArrayPtr
+    SIMPLE_VECTOR_CONSTEXPR void ResetAllocator(const Allocator& alloc) {
+        assert(raw_ptr_ == nullptr);
+        alloc_ = alloc;
+    }
+
+    // Обменивается значениям указателя на массив с объектом other.
+    // Аллокаторы обмениваются, только если этого требует
+    // propagate_on_container_swap. Иначе они должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR void swap(ArrayPtr& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
         std::swap(raw_ptr_, other.raw_ptr_);
+        std::swap(size_, other.size_);
     }
 
 private:
+    SIMPLE_VECTOR_CONSTEXPR void Deallocate() noexcept {
+        if (raw_ptr_ != nullptr) {
+            AllocTraits::deallocate(alloc_, raw_ptr_, size_);
+            raw_ptr_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_ = Allocator();
     Type* raw_ptr_ = nullptr;
+    size_t size_ = 0;
 };
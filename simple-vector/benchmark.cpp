@@ -0,0 +1,298 @@
+// Сравнение производительности SimpleVector и std::vector.
+// Отдельная программа на Google Benchmark, результаты по умолчанию выводятся
+// в формате JSON (см. README.md)
+
+#include "simple_vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Элементы больших размеров для строк и move-only типа занимают гигабайты,
+// поэтому верхнюю границу можно понизить при сборке
+#ifndef SIMPLE_VECTOR_BENCH_MAX_SIZE
+#define SIMPLE_VECTOR_BENCH_MAX_SIZE 100000000
+#endif
+
+constexpr int64_t kMaxSize = SIMPLE_VECTOR_BENCH_MAX_SIZE;
+// Вставка и удаление в начале работают за O(n) на элемент
+constexpr int64_t kMaxQuadraticSize = 100000;
+
+// Перемещаемый, но не копируемый тип, как X в main.cpp
+class MoveOnly {
+public:
+    explicit MoveOnly(size_t value)
+        : value_(value) {
+    }
+    MoveOnly(const MoveOnly&) = delete;
+    MoveOnly& operator=(const MoveOnly&) = delete;
+    MoveOnly(MoveOnly&& other) noexcept
+        : value_(std::exchange(other.value_, 0)) {
+    }
+    MoveOnly& operator=(MoveOnly&& other) noexcept {
+        value_ = std::exchange(other.value_, 0);
+        return *this;
+    }
+    size_t GetValue() const {
+        return value_;
+    }
+
+private:
+    size_t value_;
+};
+
+template <typename Type>
+Type MakeValue(size_t index);
+
+template <>
+int MakeValue<int>(size_t index) {
+    return static_cast<int>(index);
+}
+
+// Строка длиннее буфера SSO, чтобы копирование обращалось к куче
+template <>
+std::string MakeValue<std::string>(size_t index) {
+    return std::string("simple-vector-benchmark-") + std::to_string(index);
+}
+
+template <>
+MoveOnly MakeValue<MoveOnly>(size_t index) {
+    return MoveOnly(index);
+}
+
+size_t Touch(int value) {
+    return static_cast<size_t>(value);
+}
+
+size_t Touch(const std::string& value) {
+    return value.size();
+}
+
+size_t Touch(const MoveOnly& value) {
+    return value.GetValue();
+}
+
+// Единый интерфейс к обоим контейнерам
+template <typename Type>
+void PushBack(std::vector<Type>& v, Type&& value) {
+    v.push_back(std::move(value));
+}
+
+template <typename Type>
+void PushBack(SimpleVector<Type>& v, Type&& value) {
+    v.PushBack(std::move(value));
+}
+
+template <typename Type>
+void Reserve(std::vector<Type>& v, size_t capacity) {
+    v.reserve(capacity);
+}
+
+template <typename Type>
+void Reserve(SimpleVector<Type>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename Type>
+void InsertAt(std::vector<Type>& v, size_t index, Type&& value) {
+    v.insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void InsertAt(SimpleVector<Type>& v, size_t index, Type&& value) {
+    v.Insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void EraseAt(std::vector<Type>& v, size_t index) {
+    v.erase(v.begin() + index);
+}
+
+template <typename Type>
+void EraseAt(SimpleVector<Type>& v, size_t index) {
+    v.Erase(v.begin() + index);
+}
+
+template <typename Type>
+size_t Size(const std::vector<Type>& v) {
+    return v.size();
+}
+
+template <typename Type>
+size_t Size(const SimpleVector<Type>& v) {
+    return v.GetSize();
+}
+
+template <typename Vector>
+Vector MakeFilled(size_t size) {
+    using Type = std::decay_t<decltype(*std::declval<Vector&>().begin())>;
+    Vector v;
+    Reserve(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        PushBack(v, MakeValue<Type>(i));
+    }
+    return v;
+}
+
+template <typename Vector, typename Type>
+void BM_PushBack(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Vector v;
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(v, MakeValue<Type>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Vector, typename Type>
+void BM_ReservePushBack(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Vector v;
+        Reserve(v, size);
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(v, MakeValue<Type>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Vector, typename Type>
+void BM_InsertFront(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Vector v;
+        for (size_t i = 0; i < size; ++i) {
+            InsertAt(v, 0, MakeValue<Type>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Vector, typename Type>
+void BM_InsertMiddle(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Vector v;
+        for (size_t i = 0; i < size; ++i) {
+            InsertAt(v, Size(v) / 2, MakeValue<Type>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Vector, typename Type>
+void BM_EraseMiddle(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Vector v = MakeFilled<Vector>(size);
+        state.ResumeTiming();
+        while (Size(v) != 0) {
+            EraseAt(v, Size(v) / 2);
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Vector, typename Type>
+void BM_Copy(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const Vector source = MakeFilled<Vector>(size);
+    for (auto _ : state) {
+        Vector copy(source);
+        benchmark::DoNotOptimize(copy.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Vector, typename Type>
+void BM_Move(benchmark::State& state) {
+    const size_t size = state.range(0);
+    Vector source = MakeFilled<Vector>(size);
+    for (auto _ : state) {
+        Vector moved(std::move(source));
+        benchmark::DoNotOptimize(moved.begin());
+        source = std::move(moved);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Vector, typename Type>
+void BM_Iterate(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const Vector v = MakeFilled<Vector>(size);
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (const Type& item : v) {
+            sum += Touch(item);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void LinearSizes(benchmark::internal::Benchmark* bench) {
+    bench->RangeMultiplier(10)->Range(1, kMaxSize);
+}
+
+void QuadraticSizes(benchmark::internal::Benchmark* bench) {
+    bench->RangeMultiplier(10)->Range(1, std::min(kMaxSize, kMaxQuadraticSize));
+}
+
+#define SIMPLE_VECTOR_BENCH(func, type, sizes)                                   \
+    BENCHMARK_TEMPLATE(func, SimpleVector<type>, type)->Apply(sizes);             \
+    BENCHMARK_TEMPLATE(func, std::vector<type>, type)->Apply(sizes)
+
+#define SIMPLE_VECTOR_BENCH_MOVABLE(type)                                       \
+    SIMPLE_VECTOR_BENCH(BM_PushBack, type, LinearSizes);                         \
+    SIMPLE_VECTOR_BENCH(BM_ReservePushBack, type, LinearSizes);                  \
+    SIMPLE_VECTOR_BENCH(BM_InsertFront, type, QuadraticSizes);                   \
+    SIMPLE_VECTOR_BENCH(BM_InsertMiddle, type, QuadraticSizes);                  \
+    SIMPLE_VECTOR_BENCH(BM_EraseMiddle, type, QuadraticSizes);                   \
+    SIMPLE_VECTOR_BENCH(BM_Move, type, LinearSizes);                             \
+    SIMPLE_VECTOR_BENCH(BM_Iterate, type, LinearSizes)
+
+SIMPLE_VECTOR_BENCH_MOVABLE(int);
+SIMPLE_VECTOR_BENCH(BM_Copy, int, LinearSizes);
+
+SIMPLE_VECTOR_BENCH_MOVABLE(std::string);
+SIMPLE_VECTOR_BENCH(BM_Copy, std::string, LinearSizes);
+
+SIMPLE_VECTOR_BENCH_MOVABLE(MoveOnly);
+
+}  // namespace
+
+// Как BENCHMARK_MAIN, но по умолчанию выводит результаты в JSON, чтобы их
+// можно было сравнивать между версиями (tools/compare.py из Google Benchmark)
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+    const bool has_format = std::any_of(args.begin(), args.end(), [](const char* arg) {
+        return std::string(arg).rfind("--benchmark_format", 0) == 0;
+    });
+    std::string json_format = "--benchmark_format=json";
+    if (!has_format) {
+        args.push_back(json_format.data());
+    }
+
+    int args_count = static_cast<int>(args.size());
+    benchmark::Initialize(&args_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
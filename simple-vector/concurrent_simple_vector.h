@@ -0,0 +1,327 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Вектор, в который многие потоки одновременно добавляют элементы без блокировок.
+// Элементы хранятся в сегментах, которые никогда не перемещаются: сегмент k
+// вмещает kFirstSegmentSize << k элементов, поэтому рост не делает
+// недействительными ссылки, полученные читателями. Добавление захватывает индекс
+// атомарным счётчиком и создаёт элемент на своём месте; первый поток, которому
+// понадобился сегмент, выделяет его и публикует через compare_exchange.
+// Каждое место хранит флаг готовности: элемент с индексом index можно читать из
+// другого потока, когда IsReady(index) вернул true.
+// Аллокатор должен допускать одновременные вызовы allocate и construct из
+// разных потоков. Разрушение, Clear и ToSimpleVector требуют, чтобы другие
+// потоки не обращались к вектору
+template <typename Type, typename Allocator = std::allocator<Type>>
+class ConcurrentSimpleVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using State = std::atomic<uint8_t>;
+    using StateAllocator = typename AllocTraits::template rebind_alloc<State>;
+    using StateAllocTraits = std::allocator_traits<StateAllocator>;
+
+public:
+    static constexpr size_t kFirstSegmentShift = 6;
+    static constexpr size_t kFirstSegmentSize = size_t{1} << kFirstSegmentShift;
+
+    ConcurrentSimpleVector() noexcept(noexcept(Allocator())) = default;
+
+    explicit ConcurrentSimpleVector(const Allocator& alloc) noexcept
+        : alloc_(alloc) {
+    }
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector() {
+        Clear();
+    }
+
+    // Добавляет элемент и возвращает ссылку на него. Ссылка остаётся
+    // действительной до разрушения вектора или вызова Clear.
+    // Если после захвата места выбросили исключение выделение сегмента или
+    // конструктор элемента, место остаётся занятым, помечается неудавшимся и
+    // никогда не становится готовым. Сегмент, массив состояний которого
+    // выделить не удалось, помечается неудавшимся целиком: добавление в него
+    // выбрасывает std::bad_alloc
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        const size_t index = ClaimIndex();
+        const size_t segment = SegmentOf(index);
+        const size_t offset = OffsetOf(index, segment);
+        State* states = nullptr;
+        try {
+            states = EnsureStates(segment);
+        } catch (...) {
+            MarkFailed(segment, offset);
+            throw;
+        }
+        Type* item = nullptr;
+        try {
+            item = EnsureItems(segment) + offset;
+            AllocTraits::construct(alloc_, item, std::forward<Args>(args)...);
+        } catch (...) {
+            states[offset].store(kFailed, std::memory_order_release);
+            throw;
+        }
+        states[offset].store(kReady, std::memory_order_release);
+
+        return *item;
+    }
+
+    Type& PushBack(const Type& item) {
+        return EmplaceBack(item);
+    }
+
+    Type& PushBack(Type&& item) {
+        return EmplaceBack(std::move(item));
+    }
+
+    // Выделяет сегменты под new_capacity элементов заранее. Может вызываться
+    // одновременно с добавлением
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetMaxSize()) {
+            throw std::length_error("Exceeded max size");
+        }
+        for (size_t segment = 0; SegmentStart(segment) < new_capacity; ++segment) {
+            EnsureItems(segment);
+            EnsureStates(segment);
+        }
+    }
+
+    // Возвращает число захваченных мест. Элементы на некоторых из них могут
+    // ещё создаваться другими потоками. Индексы, захваченные сверх GetMaxSize,
+    // не учитываются
+    size_t GetSize() const noexcept {
+        return std::min(cursor_.load(std::memory_order_acquire), GetMaxSize());
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Сообщает, создан ли элемент с индексом index. После true элемент можно
+    // читать из этого потока
+    bool IsReady(size_t index) const noexcept {
+        if (index >= GetSize()) {
+            return false;
+        }
+        const size_t segment = SegmentOf(index);
+        const State* states = states_[segment].load(std::memory_order_acquire);
+        return states != nullptr && states != FailedStates() &&
+               states[OffsetOf(index, segment)].load(std::memory_order_acquire) == kReady;
+    }
+
+    // Возвращает ссылку на готовый элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert(IsReady(index));
+        return ItemAt(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(IsReady(index));
+        return ItemAt(index);
+    }
+
+    // Выбрасывает исключение std::out_of_range, если элемент с индексом index
+    // ещё не создан
+    Type& At(size_t index) {
+        if (!IsReady(index)) {
+            throw std::out_of_range("Out of range");
+        }
+        return ItemAt(index);
+    }
+
+    const Type& At(size_t index) const {
+        if (!IsReady(index)) {
+            throw std::out_of_range("Out of range");
+        }
+        return ItemAt(index);
+    }
+
+    // Копирует готовые элементы подряд в обычный вектор
+    SimpleVector<Type, Allocator> ToSimpleVector() const {
+        SimpleVector<Type, Allocator> result(alloc_);
+        const size_t size = GetSize();
+        result.Reserve(size);
+        for (size_t index = 0; index < size; ++index) {
+            if (IsReady(index)) {
+                result.PushBack((*this)[index]);
+            }
+        }
+        return result;
+    }
+
+    // Разрушает элементы и освобождает сегменты. Не потокобезопасен
+    void Clear() noexcept {
+        const size_t size = GetSize();
+        StateAllocator state_alloc(alloc_);
+        for (size_t segment = 0; segment < kMaxSegments; ++segment) {
+            Type* items = items_[segment].load(std::memory_order_relaxed);
+            State* states = states_[segment].load(std::memory_order_relaxed);
+            const size_t capacity = SegmentSize(segment);
+            if (states == FailedStates()) {
+                states = nullptr;
+                states_[segment].store(nullptr, std::memory_order_relaxed);
+            }
+            if (items != nullptr && states != nullptr) {
+                const size_t start = SegmentStart(segment);
+                const size_t count = size > start ? std::min(size - start, capacity) : 0;
+                for (size_t offset = 0; offset < count; ++offset) {
+                    if (states[offset].load(std::memory_order_relaxed) == kReady) {
+                        AllocTraits::destroy(alloc_, items + offset);
+                    }
+                }
+            }
+            if (items != nullptr) {
+                AllocTraits::deallocate(alloc_, items, capacity);
+                items_[segment].store(nullptr, std::memory_order_relaxed);
+            }
+            if (states != nullptr) {
+                DeallocateStates(state_alloc, states, capacity);
+                states_[segment].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        cursor_.store(0, std::memory_order_relaxed);
+    }
+
+    size_t GetMaxSize() const noexcept {
+        return std::min<size_t>(AllocTraits::max_size(alloc_),
+                                SegmentStart(kMaxSegments - 1));
+    }
+
+private:
+    static constexpr uint8_t kEmpty = 0;
+    static constexpr uint8_t kReady = 1;
+    static constexpr uint8_t kFailed = 2;
+    static constexpr size_t kMaxSegments = 64 - kFirstSegmentShift;
+
+    static size_t SegmentOf(size_t index) noexcept {
+        const unsigned long long blocks = (index >> kFirstSegmentShift) + 1;
+        return static_cast<size_t>(63 - __builtin_clzll(blocks));
+    }
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return kFirstSegmentSize << segment;
+    }
+
+    // Индекс первого элемента сегмента
+    static size_t SegmentStart(size_t segment) noexcept {
+        return SegmentSize(segment) - kFirstSegmentSize;
+    }
+
+    static size_t OffsetOf(size_t index, size_t segment) noexcept {
+        return index - SegmentStart(segment);
+    }
+
+    // Захватывает следующий индекс одним fetch_add, без повторных попыток.
+    // Заполненный вектор отсекается предварительной проверкой счётчика.
+    // Индексы, которые одновременные вызовы всё же захватили сверх
+    // GetMaxSize, не публикуются: GetSize их не учитывает
+    size_t ClaimIndex() {
+        const size_t max_size = GetMaxSize();
+        if (cursor_.load(std::memory_order_relaxed) < max_size) {
+            const size_t index = cursor_.fetch_add(1, std::memory_order_relaxed);
+            if (index < max_size) {
+                return index;
+            }
+        }
+        throw std::length_error("Exceeded max size");
+    }
+
+    // Метка вместо массива состояний сегмента, который не удалось выделить
+    static State* FailedStates() noexcept {
+        static State failed(kFailed);
+        return &failed;
+    }
+
+    // Помечает место неудавшимся. Если массив состояний сегмента так и не
+    // выделен, неудавшимся помечается весь сегмент
+    void MarkFailed(size_t segment, size_t offset) noexcept {
+        State* states = nullptr;
+        if (states_[segment].compare_exchange_strong(states, FailedStates(),
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+            return;
+        }
+        if (states != FailedStates()) {
+            states[offset].store(kFailed, std::memory_order_release);
+        }
+    }
+
+    Type& ItemAt(size_t index) const noexcept {
+        const size_t segment = SegmentOf(index);
+        return items_[segment].load(std::memory_order_acquire)[OffsetOf(index, segment)];
+    }
+
+    // Возвращает буфер элементов сегмента, выделяя его, если он ещё не выделен.
+    // Из нескольких одновременно выделенных буферов публикуется один, остальные
+    // освобождаются
+    Type* EnsureItems(size_t segment) {
+        Type* items = items_[segment].load(std::memory_order_acquire);
+        if (items != nullptr) {
+            return items;
+        }
+        Type* allocated = AllocTraits::allocate(alloc_, SegmentSize(segment));
+        if (items_[segment].compare_exchange_strong(items, allocated,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)) {
+            return allocated;
+        }
+        AllocTraits::deallocate(alloc_, allocated, SegmentSize(segment));
+        return items;
+    }
+
+    // Возвращает массив состояний сегмента, выделяя его при необходимости.
+    // Для неудавшегося сегмента выбрасывает исключение std::bad_alloc
+    State* EnsureStates(size_t segment) {
+        State* states = states_[segment].load(std::memory_order_acquire);
+        if (states == FailedStates()) {
+            throw std::bad_alloc();
+        }
+        if (states != nullptr) {
+            return states;
+        }
+        StateAllocator state_alloc(alloc_);
+        const size_t count = SegmentSize(segment);
+        State* allocated = StateAllocTraits::allocate(state_alloc, count);
+        for (size_t i = 0; i < count; ++i) {
+            StateAllocTraits::construct(state_alloc, allocated + i, kEmpty);
+        }
+        if (states_[segment].compare_exchange_strong(states, allocated,
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+            return allocated;
+        }
+        DeallocateStates(state_alloc, allocated, count);
+        if (states == FailedStates()) {
+            throw std::bad_alloc();
+        }
+        return states;
+    }
+
+    static void DeallocateStates(StateAllocator& state_alloc, State* states,
+                                 size_t count) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            StateAllocTraits::destroy(state_alloc, states + i);
+        }
+        StateAllocTraits::deallocate(state_alloc, states, count);
+    }
+
+    [[no_unique_address]] Allocator alloc_;
+    std::atomic<Type*> items_[kMaxSegments] = {};
+    std::atomic<State*> states_[kMaxSegments] = {};
+    // Счётчик на отдельной кэш-линии, чтобы добавление не конкурировало с
+    // чтением указателей на сегменты
+    alignas(64) std::atomic<size_t> cursor_{0};
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+// Если компилятор и стандартная библиотека допускают выделение памяти во время
+// компиляции (C++20), основные операции SimpleVector, ArrayPtr и StaticVector
+// объявляются constexpr. Память, выделенная при вычислении константного
+// выражения, должна быть освобождена до его окончания
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L && \
+    defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 1
+#define SIMPLE_VECTOR_CONSTEXPR constexpr
+#else
+#define SIMPLE_VECTOR_CONSTEXPR
+#endif
+
+namespace detail {
+
+// Сообщает, вычисляется ли вызов во время компиляции. Побайтовые быстрые пути
+// (memcpy, memmove) в константных выражениях недопустимы и пропускаются
+constexpr bool IsConstantEvaluated() noexcept {
+#if defined(SIMPLE_VECTOR_HAS_CONSTEXPR)
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+}  // namespace detail
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Вектор с копированием при записи. Копии разделяют один буфер со счётчиком
+// ссылок shared_ptr, поэтому копирование занимает O(1). Первый изменяющий
+// вызов у копии, буфер которой разделён с другими, копирует элементы в
+// собственный буфер (отсоединяется). Константные методы буфер не копируют.
+// Копии можно раздавать потокам: каждый поток читает и изменяет свою копию
+// без внешней синхронизации. Одну и ту же копию, как и любой вектор, нельзя
+// изменять одновременно с обращениями к ней из других потоков.
+// Указатели и итераторы, полученные до изменяющего вызова, могут указывать
+// на буфер, который этот вектор больше не использует. Ссылки и итераторы,
+// полученные до того, как с вектора сделана копия, указывают в разделённый
+// буфер: запись через них видна и в копии
+template <typename Type, typename Allocator = std::allocator<Type>,
+          typename GrowthPolicy = DoublingGrowth>
+class CowSimpleVector {
+public:
+    using VectorType = SimpleVector<Type, Allocator, GrowthPolicy>;
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    CowSimpleVector() noexcept = default;
+
+    // Забирает элементы vector без копирования
+    explicit CowSimpleVector(VectorType vector)
+        : vector_(std::make_shared<VectorType>(std::move(vector))) {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    CowSimpleVector(size_t size, const Type& value)
+        : vector_(std::make_shared<VectorType>(size, value)) {
+    }
+
+    // Создаёт вектор из std::initializer_list
+    CowSimpleVector(std::initializer_list<Type> init)
+        : vector_(std::make_shared<VectorType>(init)) {
+    }
+
+    // Копирование увеличивает счётчик ссылок на общий буфер
+    CowSimpleVector(const CowSimpleVector&) noexcept = default;
+    CowSimpleVector(CowSimpleVector&&) noexcept = default;
+    CowSimpleVector& operator=(const CowSimpleVector&) noexcept = default;
+    CowSimpleVector& operator=(CowSimpleVector&&) noexcept = default;
+
+    // Сообщает, разделён ли буфер с другими векторами
+    bool IsShared() const noexcept { return vector_.use_count() > 1; }
+
+    // Возвращает вектор с элементами без отсоединения
+    const VectorType& GetVector() const noexcept {
+        return vector_ != nullptr ? *vector_ : EmptyVector();
+    }
+
+    // Отсоединяется при необходимости и возвращает собственный вектор,
+    // который можно изменять
+    VectorType& Mutable() {
+        Detach();
+        return *vector_;
+    }
+
+    size_t GetSize() const noexcept { return GetVector().GetSize(); }
+
+    size_t GetCapacity() const noexcept { return GetVector().GetCapacity(); }
+
+    bool IsEmpty() const noexcept { return GetVector().IsEmpty(); }
+
+    const Type* Data() const noexcept { return GetVector().Data(); }
+
+    // Возвращает константную ссылку на элемент с индексом index без
+    // отсоединения
+    const Type& operator[](size_t index) const noexcept { return GetVector()[index]; }
+
+    // Возвращает ссылку на элемент с индексом index. Отсоединяется, если
+    // буфер разделён
+    Type& operator[](size_t index) {
+        assert(index < GetSize());
+        return Mutable()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const { return GetVector().At(index); }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size.
+    // Отсоединяется только при допустимом индексе
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Out of range");
+        }
+        return Mutable()[index];
+    }
+
+    void PushBack(const Type& item) { Mutable().PushBack(item); }
+
+    void PushBack(Type&& item) { Mutable().PushBack(std::move(item)); }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return Mutable().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Итератор pos может указывать в разделённый буфер: позиция
+    // пересчитывается после отсоединения
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        const size_t index = IndexOf(pos);
+        VectorType& vector = Mutable();
+        return vector.Insert(vector.begin() + index, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        const size_t index = IndexOf(pos);
+        VectorType& vector = Mutable();
+        return vector.Insert(vector.begin() + index, std::move(value));
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = IndexOf(pos);
+        VectorType& vector = Mutable();
+        return vector.Erase(vector.begin() + index);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t first_index = IndexOf(first);
+        const size_t last_index = IndexOf(last);
+        VectorType& vector = Mutable();
+        return vector.Erase(vector.begin() + first_index, vector.begin() + last_index);
+    }
+
+    void PopBack() { Mutable().PopBack(); }
+
+    void Resize(size_t new_size) { Mutable().Resize(new_size); }
+
+    void Reserve(size_t new_capacity) { Mutable().Reserve(new_capacity); }
+
+    // Очищает вектор. Разделённый буфер не копируется, а просто отпускается
+    void Clear() noexcept {
+        if (vector_ == nullptr) {
+            return;
+        }
+        if (IsUnique()) {
+            vector_->Clear();
+        } else {
+            vector_.reset();
+        }
+    }
+
+    void swap(CowSimpleVector& other) noexcept { vector_.swap(other.vector_); }
+
+    // Изменяющий обход отсоединяется
+    Iterator begin() { return Mutable().begin(); }
+
+    Iterator end() { return Mutable().end(); }
+
+    ConstIterator begin() const noexcept { return GetVector().begin(); }
+
+    ConstIterator end() const noexcept { return GetVector().end(); }
+
+    ConstIterator cbegin() const noexcept { return GetVector().begin(); }
+
+    ConstIterator cend() const noexcept { return GetVector().end(); }
+
+private:
+    static const VectorType& EmptyVector() noexcept {
+        static const VectorType empty;
+        return empty;
+    }
+
+    size_t IndexOf(ConstIterator pos) const noexcept {
+        assert(pos >= begin() && pos <= end());
+        return pos - begin();
+    }
+
+    // Сообщает, что непустой буфер принадлежит только этому вектору и его
+    // можно изменять на месте. Счётчик ссылок, равный единице, не может
+    // вырасти в другом потоке: копию можно сделать только из этого вектора.
+    // use_count() читает счётчик без упорядочивания, поэтому барьер захвата
+    // связывает изменение с уменьшением счётчика в деструкторе последней
+    // другой копии, и её чтения буфера завершаются до записи
+    bool IsUnique() const noexcept {
+        if (vector_.use_count() != 1) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    // Даёт вектору собственный буфер
+    void Detach() {
+        if (vector_ == nullptr) {
+            vector_ = std::make_shared<VectorType>();
+        } else if (!IsUnique()) {
+            vector_ = std::make_shared<VectorType>(*vector_);
+        }
+    }
+
+    std::shared_ptr<VectorType> vector_;
+};
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator==(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return lhs.GetVector() == rhs.GetVector();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator!=(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator<(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+               const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return lhs.GetVector() < rhs.GetVector();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator<=(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator>(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+               const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator>=(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Определение доступных наборов SIMD-инструкций.
+// Базовый набор платформы (SSE2 на x86-64, NEON на AArch64) известен при
+// компиляции. Более широкие наборы проверяются во время выполнения, а функции,
+// которые их используют, компилируются с атрибутом SIMPLE_VECTOR_TARGET_*,
+// поэтому вся программа не требует флагов -mavx2 и запускается на любом
+// процессоре архитектуры
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMPLE_VECTOR_HAS_X86_SIMD 1
+#define SIMPLE_VECTOR_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMPLE_VECTOR_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define SIMPLE_VECTOR_HAS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace detail {
+
+// Сообщает, поддерживает ли процессор AVX2
+inline bool CpuHasAvx2() noexcept {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+#else
+    return false;
+#endif
+}
+
+// Сообщает, поддерживает ли процессор AVX2 вместе с FMA
+inline bool CpuHasAvx2Fma() noexcept {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+    static const bool has_avx2_fma =
+        __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return has_avx2_fma;
+#else
+    return false;
+#endif
+}
+
+}  // namespace detail
@@ -0,0 +1,443 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "simd_compare.h"
+#include "trivially_relocatable.h"
+#include "uninitialized_memory.h"
+
+// Вектор с запасом памяти с обеих сторон элементов. Элементы лежат подряд,
+// как в SimpleVector, но начинаются со смещения внутри буфера, поэтому
+// PushFront и PopFront выполняются за амортизированное O(1), а Insert и Erase
+// сдвигают ту часть элементов, которая короче.
+// Когда запаса с нужной стороны не осталось, а буфер заполнен не больше чем
+// наполовину, элементы переносятся к середине буфера без перевыделения.
+// Иначе буфер растёт согласно GrowthPolicy, и новый запас достаётся той
+// стороне, с которой он закончился
+template <typename Type, typename Allocator = std::allocator<Type>,
+          typename GrowthPolicy = DoublingGrowth>
+class DequeSimpleVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    DequeSimpleVector() noexcept(noexcept(Allocator())) = default;
+
+    explicit DequeSimpleVector(const Allocator& alloc) noexcept
+        : items_(alloc) {
+    }
+
+    // Создаёт вектор из size копий value
+    DequeSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        detail::UninitializedFill(Alloc(), items_.Get(), size, value);
+        size_ = size;
+    }
+
+    DequeSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : items_(init.size(), alloc) {
+        detail::UninitializedCopy(Alloc(), init.begin(), init.end(), items_.Get());
+        size_ = init.size();
+    }
+
+    // Копия не получает запаса: её вместимость равна размеру оригинала
+    DequeSimpleVector(const DequeSimpleVector& other)
+        : items_(other.size_, AllocTraits::select_on_container_copy_construction(
+                                  other.items_.GetAllocator())) {
+        detail::UninitializedCopy(Alloc(), other.begin(), other.end(), items_.Get());
+        size_ = other.size_;
+    }
+
+    DequeSimpleVector(DequeSimpleVector&& other) noexcept
+        : items_(std::move(other.items_)),
+          front_(std::exchange(other.front_, 0)),
+          size_(std::exchange(other.size_, 0)) {
+    }
+
+    DequeSimpleVector& operator=(const DequeSimpleVector& rhs) {
+        if (this != &rhs) {
+            DequeSimpleVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    DequeSimpleVector& operator=(DequeSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            DequeSimpleVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~DequeSimpleVector() {
+        Clear();
+    }
+
+    // Создаёт элемент из args в конце вектора и возвращает ссылку на него
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (GetBackSlack() == 0) {
+            // args могут ссылаться на элементы, которые будут перенесены
+            Type value(std::forward<Args>(args)...);
+            MakeRoomBack(1);
+            AllocTraits::construct(Alloc(), end(), std::move(value));
+        } else {
+            AllocTraits::construct(Alloc(), end(), std::forward<Args>(args)...);
+        }
+        ++size_;
+        return *(end() - 1);
+    }
+
+    // Создаёт элемент из args в начале вектора и возвращает ссылку на него
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        if (GetFrontSlack() == 0) {
+            Type value(std::forward<Args>(args)...);
+            MakeRoomFront(1);
+            AllocTraits::construct(Alloc(), begin() - 1, std::move(value));
+        } else {
+            AllocTraits::construct(Alloc(), begin() - 1, std::forward<Args>(args)...);
+        }
+        --front_;
+        ++size_;
+        return *begin();
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    void PushFront(const Type& item) {
+        EmplaceFront(item);
+    }
+
+    void PushFront(Type&& item) {
+        EmplaceFront(std::move(item));
+    }
+
+    // Удаляет последний элемент. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        AllocTraits::destroy(Alloc(), end());
+    }
+
+    // Удаляет первый элемент. Вектор не должен быть пустым
+    void PopFront() noexcept {
+        assert(!IsEmpty());
+        AllocTraits::destroy(Alloc(), begin());
+        ++front_;
+        --size_;
+    }
+
+    // Вставляет value в позицию pos, сдвигая более короткую часть вектора.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = pos - begin();
+        if (index == size_) {
+            EmplaceBack(std::forward<Args>(args)...);
+            return end() - 1;
+        }
+        if (index == 0) {
+            EmplaceFront(std::forward<Args>(args)...);
+            return begin();
+        }
+
+        Type value(std::forward<Args>(args)...);
+        if (index < size_ - index) {
+            MakeRoomFront(1);
+            detail::InsertShiftedFront(Alloc(), begin(), begin() + index, std::move(value));
+            --front_;
+        } else {
+            MakeRoomBack(1);
+            detail::InsertShifted(Alloc(), begin() + index, end(), std::move(value));
+        }
+        ++size_;
+
+        return begin() + index;
+    }
+
+    // Удаляет элемент в позиции pos, сдвигая более короткую часть вектора.
+    // Возвращает итератор на элемент, следовавший за удалённым
+    Iterator Erase(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая более короткую часть вектора.
+    // Возвращает итератор на элемент, следовавший за удалёнными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        Type* data = begin();
+        if (index < size_ - index - count) {
+            detail::EraseRangeShiftedFront(Alloc(), data, data + index, data + index + count);
+            front_ += count;
+        } else {
+            detail::EraseRangeShifted(Alloc(), data + index, data + index + count, end());
+        }
+        size_ -= count;
+
+        return begin() + index;
+    }
+
+    // Резервирует место под new_capacity элементов, сохраняя запас в начале
+    // Выбрасывает исключение std::length_error, если new_capacity > GetMaxSize()
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate(CheckCapacity(new_capacity),
+                       std::min(front_, new_capacity - size_));
+        }
+    }
+
+    // Изменяет размер. Новые элементы в конце получают значение по умолчанию
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            detail::Destroy(Alloc(), begin() + new_size, end());
+            size_ = new_size;
+            return;
+        }
+        if (GetBackSlack() < new_size - size_) {
+            MakeRoomBack(new_size - size_);
+        }
+        detail::UninitializedValueConstruct(Alloc(), end(), new_size - size_);
+        size_ = new_size;
+    }
+
+    // Разрушает все элементы. Вместимость сохраняется, весь запас переходит
+    // в конец буфера
+    void Clear() noexcept {
+        detail::Destroy(Alloc(), begin(), end());
+        size_ = 0;
+        front_ = 0;
+    }
+
+    void swap(DequeSimpleVector& other) noexcept {
+        items_.swap(other.items_);
+        std::swap(front_, other.front_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t GetSize() const noexcept { return size_; }
+
+    size_t GetCapacity() const noexcept { return items_.GetSize(); }
+
+    // Число элементов, которые можно добавить в начало без переноса
+    size_t GetFrontSlack() const noexcept { return front_; }
+
+    // Число элементов, которые можно добавить в конец без переноса
+    size_t GetBackSlack() const noexcept { return GetCapacity() - front_ - size_; }
+
+    bool IsEmpty() const noexcept { return size_ == 0; }
+
+    size_t GetMaxSize() const noexcept {
+        return AllocTraits::max_size(items_.GetAllocator());
+    }
+
+    Allocator GetAllocator() const noexcept { return items_.GetAllocator(); }
+
+    Type* Data() noexcept { return begin(); }
+
+    const Type* Data() const noexcept { return begin(); }
+
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return begin()[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return begin()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+        return begin()[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+        return begin()[index];
+    }
+
+    // Итераторная область
+    Iterator begin() noexcept { return items_.Get() + front_; }
+
+    Iterator end() noexcept { return begin() + size_; }
+
+    ConstIterator begin() const noexcept { return items_.Get() + front_; }
+
+    ConstIterator end() const noexcept { return begin() + size_; }
+
+    ConstIterator cbegin() const noexcept { return begin(); }
+
+    ConstIterator cend() const noexcept { return end(); }
+
+private:
+    // Перенос к середине буфера выполняется по одному элементу внутри того же
+    // буфера, поэтому допустим только без исключений
+    static constexpr bool kCanShiftInPlace =
+        kIsTriviallyRelocatable<Type> || std::is_nothrow_move_constructible_v<Type>;
+
+    Allocator& Alloc() noexcept { return items_.GetAllocator(); }
+
+    size_t CheckCapacity(size_t capacity) const {
+        if (capacity > GetMaxSize()) {
+            throw std::length_error("DequeSimpleVector capacity exceeds max size");
+        }
+        return capacity;
+    }
+
+    size_t GrowCapacity(size_t required) const {
+        return GrowthPolicy::NextCapacity(GetCapacity(), CheckCapacity(required),
+                                          GetMaxSize(), sizeof(Type));
+    }
+
+    // Освобождает место под count элементов в конце
+    void MakeRoomBack(size_t count) {
+        if (GetBackSlack() >= count) {
+            return;
+        }
+        if (count > GetMaxSize() - size_) {
+            throw std::length_error("DequeSimpleVector capacity exceeds max size");
+        }
+        const size_t required = size_ + count;
+        if (required <= GetCapacity() / 2) {
+            Recentre((GetCapacity() - required) / 2);
+        } else {
+            const size_t new_capacity = GrowCapacity(required);
+            Reallocate(new_capacity, std::min(front_, new_capacity - required));
+        }
+    }
+
+    // Освобождает место под count элементов в начале
+    void MakeRoomFront(size_t count) {
+        if (GetFrontSlack() >= count) {
+            return;
+        }
+        if (count > GetMaxSize() - size_) {
+            throw std::length_error("DequeSimpleVector capacity exceeds max size");
+        }
+        const size_t required = size_ + count;
+        if (required <= GetCapacity() / 2) {
+            Recentre(count + (GetCapacity() - required) / 2);
+        } else {
+            const size_t new_capacity = GrowCapacity(required);
+            Reallocate(new_capacity, new_capacity - size_ - std::min(GetBackSlack(),
+                                                                     new_capacity - required));
+        }
+    }
+
+    // Переносит элементы к смещению new_front, не меняя вместимости: внутри
+    // буфера, если это допустимо, иначе в новый буфер того же размера
+    void Recentre(size_t new_front) {
+        if constexpr (kCanShiftInPlace) {
+            ShiftInPlace(new_front);
+        } else {
+            Reallocate(GetCapacity(), new_front);
+        }
+    }
+
+    // Переносит элементы в новый буфер, начиная со смещения new_front
+    void Reallocate(size_t new_capacity, size_t new_front) {
+        ArrayPtr<Type, Allocator> new_items(new_capacity, Alloc());
+        detail::Relocate(Alloc(), begin(), end(), new_items.Get() + new_front);
+        items_.swap(new_items);
+        front_ = new_front;
+    }
+
+    // Переносит элементы внутри буфера так, чтобы они начинались со смещения
+    // new_front
+    void ShiftInPlace(size_t new_front) noexcept {
+        Type* source = begin();
+        Type* dest = items_.Get() + new_front;
+        if constexpr (kIsTriviallyRelocatable<Type>) {
+            detail::MoveBytes(dest, source, size_);
+        } else if (dest < source) {
+            for (size_t i = 0; i < size_; ++i) {
+                AllocTraits::construct(Alloc(), dest + i, std::move(source[i]));
+                AllocTraits::destroy(Alloc(), source + i);
+            }
+        } else {
+            for (size_t i = size_; i-- > 0;) {
+                AllocTraits::construct(Alloc(), dest + i, std::move(source[i]));
+                AllocTraits::destroy(Alloc(), source + i);
+            }
+        }
+        front_ = new_front;
+    }
+
+    ArrayPtr<Type, Allocator> items_;
+    // Смещение первого элемента от начала буфера
+    size_t front_ = 0;
+    size_t size_ = 0;
+};
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator==(const DequeSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                const DequeSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() &&
+           detail::ContiguousEqual(lhs.begin(), rhs.begin(), lhs.GetSize());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator!=(const DequeSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                const DequeSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator<(const DequeSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+               const DequeSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return detail::ContiguousLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator<=(const DequeSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                const DequeSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator>(const DequeSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+               const DequeSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+bool operator>=(const DequeSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                const DequeSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
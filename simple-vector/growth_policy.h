@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+// Политики роста вместимости вектора.
+// Функция NextCapacity(capacity, required, max_capacity, element_size)
+// вызывается, когда текущей вместимости capacity не хватает для required
+// элементов, и возвращает новую вместимость из диапазона
+// [required, max_capacity]. Контейнер гарантирует, что
+// capacity < required <= max_capacity. Вычисления не должны переполняться.
+// Политика может также определить функцию ShrinkCapacity(size, capacity),
+// которую контейнер вызывает после удаления элементов. Если она вернёт
+// значение меньше capacity (но не меньше size), буфер будет уменьшен
+
+// Удваивает вместимость. Пустой вектор получает ровно required элементов
+struct DoublingGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required,
+                                         size_t max_capacity,
+                                         size_t /*element_size*/) noexcept {
+        if (capacity > max_capacity / 2) {
+            return max_capacity;
+        }
+
+        return std::max(required, capacity * 2);
+    }
+};
+
+// Увеличивает вместимость в полтора раза. При таком множителе суммарный
+// размер освобождённых ранее буферов со временем превышает размер следующего,
+// и аллокатор может переиспользовать их память
+struct OneAndHalfGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required,
+                                         size_t max_capacity,
+                                         size_t /*element_size*/) noexcept {
+        if (capacity > max_capacity - capacity / 2) {
+            return max_capacity;
+        }
+
+        return std::max(required, capacity + capacity / 2);
+    }
+};
+
+// Выбирает вместимость политикой BasePolicy и округляет размер буфера
+// в байтах вверх до ближайшего класса размеров malloc: до 16 байт, затем
+// по четыре класса на каждую степень двойки. Память, которую malloc всё равно
+// выделил бы под округлённый блок, становится доступна вектору
+template <typename BasePolicy = DoublingGrowth>
+struct MallocSizeClassGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required,
+                                         size_t max_capacity,
+                                         size_t element_size) noexcept {
+        const size_t elements = BasePolicy::NextCapacity(capacity, required,
+                                                         max_capacity, element_size);
+        // Вместимость не превышает max_size аллокатора, поэтому произведение
+        // помещается в size_t
+        const size_t bytes = RoundUpToSizeClass(elements * element_size);
+
+        return std::clamp(bytes / element_size, elements, max_capacity);
+    }
+
+    static constexpr size_t RoundUpToSizeClass(size_t bytes) noexcept {
+        constexpr size_t kMinClass = 16;
+        if (bytes <= kMinClass) {
+            return kMinClass;
+        }
+
+        // Шаг классов внутри (2^k, 2^(k+1)] равен 2^(k-2), но не меньше 16 байт
+        size_t power = kMinClass;
+        while (power < bytes / 2 + bytes % 2) {
+            power *= 2;
+        }
+        const size_t step = std::max(kMinClass, power / 4);
+        const size_t rounded = (bytes + step - 1) / step * step;
+
+        return rounded < bytes ? bytes : rounded;
+    }
+};
+
+// Добавляет к политике BasePolicy автоматическое уменьшение буфера с
+// гистерезисом: когда заполненность падает ниже 1/ShrinkDivisor, вместимость
+// уменьшается до удвоенного размера. После уменьшения буфер заполнен
+// наполовину, поэтому чередование вставок и удалений не приводит к
+// перевыделению на каждой операции. Буферы вместимостью не больше MinCapacity
+// не уменьшаются
+template <typename BasePolicy = DoublingGrowth, size_t ShrinkDivisor = 4,
+          size_t MinCapacity = 16>
+struct HysteresisShrink : BasePolicy {
+    static_assert(ShrinkDivisor > 2, "Shrinking must leave room for growth");
+
+    static constexpr size_t ShrinkCapacity(size_t size, size_t capacity) noexcept {
+        if (capacity <= MinCapacity || size >= capacity / ShrinkDivisor) {
+            return capacity;
+        }
+
+        return std::max(size * 2, MinCapacity);
+    }
+};
+
+namespace detail {
+
+template <typename Policy, typename = void>
+struct HasShrinkCapacity : std::false_type {};
+
+template <typename Policy>
+struct HasShrinkCapacity<
+    Policy, std::void_t<decltype(Policy::ShrinkCapacity(size_t{}, size_t{}))>>
+    : std::true_type {};
+
+template <typename Policy>
+inline constexpr bool kHasShrinkCapacity = HasShrinkCapacity<Policy>::value;
+
+}  // namespace detail
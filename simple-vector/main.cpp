@@ -1,9 +1,33 @@
+#include "concurrent_simple_vector.h"
+#include "cow_simple_vector.h"
+#include "deque_simple_vector.h"
+#include "mmap_allocator.h"
+#include "numeric_kernels.h"
+#include "parallel_algorithms.h"
+#include "prefetch.h"
+#include "ring_buffer.h"
+#include "segmented_simple_vector.h"
 #include "simple_vector.h"
+#include "simple_vector_view.h"
+#include "small_simple_vector.h"
+#include "soa_simple_vector.h"
+#include "static_vector.h"
+#include "thread_local_appender.h"
+#include "vector_file.h"
 
 #include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <list>
+#include <sstream>
+#include <memory_resource>
+#include <mutex>
 #include <numeric>
+#include <random>
 #include <string>
+#include <thread>
 
 using namespace std;
 
@@ -32,6 +56,142 @@ private:
     size_t x_;
 };
 
+// Тип без конструктора по умолчанию, считающий живые экземпляры
+class Counted {
+public:
+    explicit Counted(int value)
+        : value_(value) {
+        ++alive;
+    }
+    Counted(const Counted& other)
+        : value_(other.value_) {
+        ++alive;
+    }
+    Counted(Counted&& other) noexcept
+        : value_(exchange(other.value_, 0)) {
+        ++alive;
+    }
+    Counted& operator=(const Counted& other) = default;
+    Counted& operator=(Counted&& other) noexcept {
+        value_ = exchange(other.value_, 0);
+        return *this;
+    }
+    ~Counted() {
+        --alive;
+    }
+    int GetValue() const {
+        return value_;
+    }
+
+    inline static int alive = 0;
+
+private:
+    int value_;
+};
+
+// Ресурс памяти, считающий выделенные байты
+class CountingResource : public pmr::memory_resource {
+public:
+    size_t allocated = 0;
+    size_t deallocated = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocated += bytes;
+        return pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        deallocated += bytes;
+        pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Дескриптор, объявленный тривиально переносимым: при росте вектора и
+// удалении элементов его перемещающий конструктор вызываться не должен
+class Handle {
+public:
+    explicit Handle(int value)
+        : value_(make_unique<int>(value)) {
+    }
+    Handle(Handle&& other) noexcept
+        : value_(move(other.value_)) {
+        ++moves;
+    }
+    Handle& operator=(Handle&& other) noexcept {
+        value_ = move(other.value_);
+        ++moves;
+        return *this;
+    }
+    int GetValue() const {
+        return *value_;
+    }
+
+    inline static int moves = 0;
+
+private:
+    unique_ptr<int> value_;
+};
+
+template <>
+struct IsTriviallyRelocatable<Handle> : true_type {};
+
+// Запись, считающая перемещения
+struct Record {
+    Record(int id, string name)
+        : id(id), name(move(name)) {
+    }
+    Record(Record&& other) noexcept
+        : id(other.id), name(move(other.name)) {
+        ++moves;
+    }
+    Record& operator=(Record&& other) noexcept {
+        id = other.id;
+        name = move(other.name);
+        ++moves;
+        return *this;
+    }
+
+    int id;
+    string name;
+    inline static int moves = 0;
+};
+
+// Тип без noexcept-перемещения, копирование которого бросает исключение
+// по требованию
+class Fragile {
+public:
+    explicit Fragile(int value)
+        : value_(value) {
+    }
+    Fragile(const Fragile& other)
+        : value_(other.value_) {
+        if (copies_left == 0) {
+            throw runtime_error("copy failed");
+        }
+        --copies_left;
+        ++copies;
+    }
+    Fragile(Fragile&& other)
+        : value_(exchange(other.value_, -1)) {
+        ++moves;
+    }
+    Fragile& operator=(const Fragile&) = default;
+    Fragile& operator=(Fragile&&) = default;
+    int GetValue() const {
+        return value_;
+    }
+
+    inline static int copies_left = numeric_limits<int>::max();
+    inline static int copies = 0;
+    inline static int moves = 0;
+
+private:
+    int value_;
+};
+
 SimpleVector<int> GenerateVector(size_t size) {
     SimpleVector<int> v(size);
     iota(v.begin(), v.end(), 1);
@@ -150,6 +310,1915 @@ void TestNoncopiableErase() {
     cout << "Done!"s << endl << endl;
 }
 
+void TestRawStorage() {
+    cout << "Test raw storage"s << endl;
+    {
+        SimpleVector<Counted> v(Reserve(10));
+        assert(v.GetCapacity() == 10);
+        assert(Counted::alive == 0);
+
+        for (int i = 0; i < 20; ++i) {
+            v.PushBack(Counted(i));
+        }
+        assert(Counted::alive == 20);
+
+        v.Insert(v.begin() + 5, Counted(100));
+        assert(v[5].GetValue() == 100 && v[6].GetValue() == 5);
+        assert(Counted::alive == 21);
+
+        v.Erase(v.begin());
+        v.PopBack();
+        assert(Counted::alive == 19);
+        assert(v[0].GetValue() == 1 && v[18].GetValue() == 18);
+
+        while (v.GetSize() > 3) {
+            v.PopBack();
+        }
+        assert(Counted::alive == 3);
+
+        SimpleVector<Counted> copy(v);
+        assert(copy.GetCapacity() == copy.GetSize());
+        copy.PushBack(copy[0]);
+        assert(copy.GetSize() == 4 && copy[3].GetValue() == 1);
+        assert(Counted::alive == 7);
+
+        v.Clear();
+        assert(Counted::alive == 4);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestPmrAllocator() {
+    cout << "Test pmr allocator"s << endl;
+    CountingResource resource;
+    CountingResource other_resource;
+    {
+        PmrSimpleVector<pmr::string> v(&resource);
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(pmr::string(50, 'a'));
+        }
+        v.Insert(v.begin(), pmr::string(50, 'b'));
+        v.Reserve(100);
+        v.Resize(120);
+        assert(v.GetAllocator().resource() == &resource);
+        // Элементы получают аллокатор контейнера
+        assert(v[0].get_allocator().resource() == &resource);
+        assert(v[0] == pmr::string(50, 'b'));
+        assert(resource.allocated > 0);
+        assert(other_resource.allocated == 0);
+
+        // Копия получает ресурс по умолчанию
+        PmrSimpleVector<pmr::string> copy(v);
+        assert(copy.GetAllocator().resource() == pmr::get_default_resource());
+        assert(copy == v);
+
+        // Аллокатор не распространяется при перемещающем присваивании
+        PmrSimpleVector<pmr::string> moved(&other_resource);
+        moved = move(v);
+        assert(moved.GetAllocator().resource() == &other_resource);
+        assert(moved.GetSize() == 120 && moved[0] == pmr::string(50, 'b'));
+        assert(other_resource.allocated > 0);
+
+        // Копирующее присваивание сохраняет собственный аллокатор
+        PmrSimpleVector<pmr::string> assigned(&resource);
+        assigned = moved;
+        assert(assigned.GetAllocator().resource() == &resource);
+        assert(assigned == moved);
+    }
+    assert(resource.allocated == resource.deallocated);
+    assert(other_resource.allocated == other_resource.deallocated);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSmallSimpleVector() {
+    cout << "Test small simple vector"s << endl;
+    using SmallVector = SmallSimpleVector<string, 4>;
+    SmallVector v;
+    assert(v.IsInline() && v.GetCapacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        v.PushBack(to_string(i));
+    }
+    assert(v.IsInline());
+    SmallVector inline_copy(v);
+
+    v.Insert(v.begin() + 1, "x"s);
+    assert(!v.IsInline() && v.GetCapacity() == 8);
+    assert(v.GetSize() == 5 && v[1] == "x"s && v[4] == "3"s);
+    v.Erase(v.begin() + 1);
+    assert((v == SmallVector{"0"s, "1"s, "2"s, "3"s}));
+    assert(v == inline_copy);
+
+    SmallVector moved_inline(move(inline_copy));
+    assert(moved_inline.IsInline() && moved_inline.GetSize() == 4);
+    assert(inline_copy.IsEmpty());
+
+    SmallVector moved_heap(move(v));
+    assert(!moved_heap.IsInline() && moved_heap.GetSize() == 4);
+
+    SmallVector small{"a"s};
+    small.swap(moved_heap);
+    assert(small.GetSize() == 4 && moved_heap.GetSize() == 1);
+    assert(moved_heap[0] == "a"s && small[3] == "3"s);
+    assert(moved_heap > small);
+
+    SmallSimpleVector<X, 2> noncopiable;
+    for (size_t i = 0; i < 5; ++i) {
+        noncopiable.PushBack(X(i));
+    }
+    noncopiable.Resize(7);
+    assert(noncopiable[4].GetX() == 4 && noncopiable[6].GetX() == 5);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestTriviallyRelocatable() {
+    cout << "Test trivially relocatable"s << endl;
+    static_assert(kIsTriviallyRelocatable<int>);
+    static_assert(kIsTriviallyRelocatable<unique_ptr<int>>);
+    static_assert(!kIsTriviallyRelocatable<string>);
+
+    SimpleVector<Handle> v;
+    for (int i = 0; i < 100; ++i) {
+        v.PushBack(Handle(i));
+    }
+    // По одному перемещению на каждый PushBack, рост обходится без них
+    assert(Handle::moves == 100);
+
+    v.Erase(v.begin());
+    assert(Handle::moves == 100);
+    // Вставка перемещает только новый элемент: во временный объект и в буфер
+    v.Insert(v.begin() + 10, Handle(1000));
+    assert(Handle::moves == 102);
+    v.Reserve(1000);
+    assert(Handle::moves == 102);
+    assert(v[0].GetValue() == 1 && v[10].GetValue() == 1000);
+    assert(v[99].GetValue() == 99);
+
+    SimpleVector<unique_ptr<int>> pointers;
+    for (int i = 0; i < 10; ++i) {
+        pointers.Insert(pointers.begin(), make_unique<int>(i));
+    }
+    pointers.Erase(pointers.begin() + 3);
+    assert(*pointers[0] == 9 && *pointers[3] == 5 && pointers.GetSize() == 9);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestGrowthPolicy() {
+    cout << "Test growth policy"s << endl;
+    {
+        SimpleVector<int, allocator<int>, OneAndHalfGrowth> v;
+        SimpleVector<size_t> capacities;
+        for (int i = 0; i < 20; ++i) {
+            if (v.GetSize() == v.GetCapacity()) {
+                capacities.PushBack(v.GetCapacity());
+            }
+            v.PushBack(i);
+        }
+        assert((capacities == SimpleVector<size_t>{0, 1, 2, 3, 4, 6, 9, 13, 19}));
+    }
+    {
+        // 120 байт округляются до класса 128, а 240 — до класса 256 байт
+        using Record = array<char, 12>;
+        SimpleVector<Record, allocator<Record>, MallocSizeClassGrowth<>> v;
+        v.Resize(10);
+        assert(v.GetCapacity() == 10);
+        v.PushBack(Record{});
+        assert(v.GetCapacity() == 21);
+        assert(MallocSizeClassGrowth<>::RoundUpToSizeClass(100) == 112);
+        assert(MallocSizeClassGrowth<>::RoundUpToSizeClass(1000) == 1024);
+        assert(MallocSizeClassGrowth<>::RoundUpToSizeClass(1025) == 1280);
+    }
+    {
+        const size_t max = numeric_limits<size_t>::max();
+        assert(DoublingGrowth::NextCapacity(max / 2 + 1, max / 2 + 2, max, 1) == max);
+        assert(OneAndHalfGrowth::NextCapacity(max - 1, max, max, 1) == max);
+
+        SimpleVector<int> v;
+        try {
+            v.Reserve(v.GetMaxSize() + 1);
+            assert(false);
+        } catch (const length_error&) {
+        }
+        try {
+            v.Resize(numeric_limits<size_t>::max());
+            assert(false);
+        } catch (const length_error&) {
+        }
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestEmplace() {
+    cout << "Test emplace"s << endl;
+    SimpleVector<Record> v(Reserve(2));
+    Record& first = v.EmplaceBack(1, "one"s);
+    assert(first.id == 1 && first.name == "one"s);
+    v.EmplaceBack(2, "two"s);
+    assert(Record::moves == 0);
+
+    auto it = v.Emplace(v.begin() + 1, 3, "three"s);
+    assert(it == v.begin() + 1 && it->name == "three"s);
+    assert(v.GetSize() == 3 && v[2].id == 2);
+
+    SimpleVector<string> strings;
+    strings.EmplaceBack(3, 'a');
+    strings.Emplace(strings.begin(), strings[0]);
+    strings.Emplace(strings.begin() + 1, "b"s);
+    assert((strings == SimpleVector<string>{"aaa"s, "b"s, "aaa"s}));
+
+    // Вставка в начало перемещает хвост и элемент из временного объекта
+    Record::moves = 0;
+    SmallSimpleVector<Record, 2> small;
+    small.EmplaceBack(1, "one"s);
+    small.Emplace(small.begin(), 0, "zero"s);
+    assert(Record::moves == 2);
+    assert(small[0].id == 0 && small[1].id == 1);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestRangeInsertion() {
+    cout << "Test range insertion"s << endl;
+    const SimpleVector<string> source{"a"s, "b"s, "c"s};
+    {
+        SimpleVector<string> v{"1"s, "2"s, "3"s, "4"s};
+        v.Reserve(20);
+        // Хвост длиннее вставляемого диапазона
+        auto it = v.InsertRange(v.begin() + 1, source.begin(), source.end());
+        assert(it == v.begin() + 1 && v.GetCapacity() == 20);
+        assert((v == SimpleVector<string>{"1"s, "a"s, "b"s, "c"s, "2"s, "3"s, "4"s}));
+        // Хвост короче вставляемого диапазона
+        v.InsertRange(v.end() - 1, source.begin(), source.end());
+        assert((v == SimpleVector<string>{"1"s, "a"s, "b"s, "c"s, "2"s, "3"s,
+                                          "a"s, "b"s, "c"s, "4"s}));
+    }
+    {
+        // Вставка с перевыделением выделяет память один раз
+        SimpleVector<int> v{1, 2, 3};
+        list<int> values{10, 20, 30, 40, 50};
+        v.InsertRange(v.begin() + 1, values.begin(), values.end());
+        assert((v == SimpleVector<int>{1, 10, 20, 30, 40, 50, 2, 3}));
+        assert(v.GetCapacity() == 8);
+        v.Append(values.begin(), values.end());
+        assert(v.GetSize() == 13 && v[12] == 50);
+    }
+    {
+        // Input-итераторы
+        SimpleVector<int> v{1, 2};
+        istringstream input("7 8 9");
+        v.InsertRange(v.begin() + 1, istream_iterator<int>(input),
+                      istream_iterator<int>());
+        assert((v == SimpleVector<int>{1, 7, 8, 9, 2}));
+        istringstream assign_input("5 6");
+        v.Assign(istream_iterator<int>(assign_input), istream_iterator<int>());
+        assert((v == SimpleVector<int>{5, 6}));
+    }
+    {
+        SimpleVector<string> v{"x"s, "y"s, "z"s, "w"s};
+        v.Assign(source.begin(), source.begin() + 2);
+        assert((v == SimpleVector<string>{"a"s, "b"s}));
+        v.Assign(source.begin(), source.end());
+        assert(v == source && v.GetCapacity() == 4);
+        v.Assign(source.begin(), source.end());
+        v.Append(source.begin(), source.end());
+        v.Assign(v.begin(), v.begin());
+        assert(v.IsEmpty());
+
+        SmallSimpleVector<string, 4> small{"1"s};
+        small.InsertRange(small.begin(), source.begin(), source.end());
+        assert(small.IsInline() && small.GetSize() == 4 && small[3] == "1"s);
+        small.Append(source.begin(), source.end());
+        assert(!small.IsInline() && small.GetSize() == 7 && small[6] == "c"s);
+        small.Assign(source.begin(), source.begin() + 1);
+        assert(small.GetSize() == 1 && small[0] == "a"s);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestRangeErase() {
+    cout << "Test range erase"s << endl;
+    {
+        SimpleVector<string> v{"0"s, "1"s, "2"s, "3"s, "4"s, "5"s};
+        auto it = v.Erase(v.begin() + 1, v.begin() + 4);
+        assert(*it == "4"s);
+        assert((v == SimpleVector<string>{"0"s, "4"s, "5"s}));
+        it = v.Erase(v.begin() + 1, v.end());
+        assert(it == v.end() && v.GetSize() == 1);
+        v.Erase(v.begin(), v.begin());
+        assert(v.GetSize() == 1);
+    }
+    {
+        SimpleVector<Counted> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        size_t removed = EraseIf(v, [](const Counted& c) {
+            return c.GetValue() % 3 != 0;
+        });
+        assert(removed == 66 && v.GetSize() == 34);
+        assert(Counted::alive == 34);
+        for (size_t i = 0; i < v.GetSize(); ++i) {
+            assert(v[i].GetValue() == static_cast<int>(i * 3));
+        }
+    }
+    assert(Counted::alive == 0);
+    {
+        SimpleVector<unique_ptr<int>> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(make_unique<int>(i));
+        }
+        v.Erase(v.begin() + 2, v.begin() + 5);
+        assert(v.GetSize() == 7 && *v[2] == 5);
+        EraseIf(v, [](const unique_ptr<int>& p) { return *p > 6; });
+        assert(v.GetSize() == 4 && *v[3] == 6);
+
+        SmallSimpleVector<int, 8> small{1, 2, 3, 4, 5};
+        assert(EraseIf(small, [](int x) { return x % 2 == 0; }) == 2);
+        assert((small == SmallSimpleVector<int, 8>{1, 3, 5}));
+        small.Erase(small.begin(), small.begin() + 2);
+        assert(small.GetSize() == 1 && small[0] == 5);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestShrink() {
+    cout << "Test shrink"s << endl;
+    {
+        SimpleVector<string> v(100, "x"s);
+        v.Resize(10);
+        assert(v.GetCapacity() == 100);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 10 && v.GetSize() == 10 && v[9] == "x"s);
+        v.Clear();
+        assert(v.GetCapacity() == 10);
+        v.PushBack("y"s);
+        v.Clear(true);
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 0);
+    }
+    {
+        SimpleVector<int, allocator<int>, HysteresisShrink<>> v;
+        for (int i = 0; i < 1024; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.GetCapacity() == 1024);
+        while (v.GetSize() > 256) {
+            v.PopBack();
+        }
+        assert(v.GetCapacity() == 1024);
+        v.PopBack();
+        assert(v.GetCapacity() == 510 && v.GetSize() == 255 && v[254] == 254);
+        // Вставки и удаления у границы не вызывают перевыделений
+        v.PushBack(255);
+        v.PopBack();
+        assert(v.GetCapacity() == 510);
+        v.Erase(v.begin(), v.begin() + 250);
+        assert(v.GetCapacity() == 16 && v.GetSize() == 5 && v[0] == 250);
+        v.Resize(1);
+        assert(v.GetCapacity() == 16);
+    }
+    {
+        SmallSimpleVector<string, 4> small(10, "a"s);
+        small.Resize(3);
+        small.ShrinkToFit();
+        assert(small.IsInline() && small.GetSize() == 3 && small[2] == "a"s);
+        small.Resize(10);
+        small.Clear(true);
+        assert(small.IsInline() && small.GetCapacity() == 4);
+
+        SmallSimpleVector<int, 4, allocator<int>, HysteresisShrink<>> auto_small;
+        for (int i = 0; i < 100; ++i) {
+            auto_small.PushBack(i);
+        }
+        auto_small.Erase(auto_small.begin() + 2, auto_small.end());
+        assert(!auto_small.IsInline() && auto_small.GetCapacity() == 16);
+        auto_small.ShrinkToFit();
+        assert(auto_small.IsInline() && auto_small[1] == 1);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestStrongExceptionGuarantee() {
+    cout << "Test strong exception guarantee"s << endl;
+    SimpleVector<Fragile> v;
+    for (int i = 0; i < 4; ++i) {
+        v.EmplaceBack(i);
+    }
+    assert(v.GetCapacity() == 4);
+
+    // Перемещение может бросить исключение, поэтому рост копирует элементы
+    Fragile::copies = 0;
+    Fragile::moves = 0;
+    v.Reserve(8);
+    assert(Fragile::copies == 4 && Fragile::moves == 0);
+
+    // Неудачное перевыделение оставляет вектор нетронутым
+    for (int i = 4; i < 8; ++i) {
+        v.EmplaceBack(i);
+    }
+    Fragile::copies_left = 5;
+    try {
+        v.PushBack(Fragile(100));
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    assert(v.GetSize() == 8 && v.GetCapacity() == 8);
+    for (int i = 0; i < 4; ++i) {
+        assert(v[i].GetValue() == i);
+    }
+
+    Fragile::copies_left = numeric_limits<int>::max();
+    const SimpleVector<Fragile> source(3, Fragile(7));
+    Fragile::copies_left = 2;
+    try {
+        v.InsertRange(v.begin(), source.begin(), source.end());
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    assert(v.GetSize() == 8 && v[0].GetValue() == 0 && v[3].GetValue() == 3);
+    Fragile::copies_left = numeric_limits<int>::max();
+
+    // Перемещение noexcept, поэтому рост элементы не копирует
+    SimpleVector<Counted> counted;
+    for (int i = 0; i < 4; ++i) {
+        counted.EmplaceBack(i);
+    }
+    counted.Reserve(100);
+    assert(counted.GetSize() == 4 && counted[3].GetValue() == 3);
+
+    // Добавление в конец не требует присваивания
+    struct Immutable {
+        explicit Immutable(int value)
+            : value(value) {
+        }
+        Immutable(const Immutable&) = default;
+        Immutable& operator=(const Immutable&) = delete;
+
+        const int value;
+    };
+    SimpleVector<Immutable> immutable;
+    for (int i = 0; i < 10; ++i) {
+        immutable.EmplaceBack(i);
+    }
+    assert(immutable[9].value == 9);
+    cout << "Done!"s << endl << endl;
+}
+
+// Тривиально копируемый тип, используемый только в тесте статистики, чтобы
+// счётчики реестра не смешивались с другими тестами
+struct StatsItem {
+    int value = 0;
+};
+
+void TestStats() {
+    cout << "Test stats"s << endl;
+#ifdef SIMPLE_VECTOR_ENABLE_STATS
+    SimpleVector<StatsItem> v;
+    for (int i = 0; i < 5; ++i) {
+        const StatsItem item{i};
+        v.PushBack(item);
+    }
+    // Вместимость росла 1, 2, 4, 8, при этом перенесено 0 + 1 + 2 + 4 элемента
+    SimpleVectorStats stats = v.GetStats();
+    assert(stats.reallocations == 4);
+    assert(stats.bytes_allocated == 15 * sizeof(StatsItem));
+    assert(stats.peak_capacity == 8);
+    assert(stats.elements_copied == 5 && stats.elements_moved == 7);
+
+    // Вставка в начало сдвигает все пять элементов, а значение перемещается
+    // через временный объект
+    v.Insert(v.begin(), StatsItem{-1});
+    stats = v.GetStats();
+    assert(stats.reallocations == 4);
+    assert(stats.elements_copied == 5 && stats.elements_moved == 14);
+
+    v.Reserve(20);
+    v.Resize(25);
+    stats = v.GetStats();
+    assert(stats.reallocations == 6);
+    assert(stats.bytes_allocated == 75 * sizeof(StatsItem));
+    assert(stats.peak_capacity == 40);
+    assert(stats.elements_moved == 26);
+
+    // Копия ведёт собственную статистику, реестр суммирует оба вектора
+    SimpleVector<StatsItem> copy(v);
+    assert(copy.GetStats().elements_copied == 25);
+    assert(copy.GetStats().reallocations == 0);
+
+    const SimpleVectorStats total = GetSimpleVectorTypeStats<StatsItem>();
+    assert(total.reallocations == 6);
+    assert(total.bytes_allocated == 100 * sizeof(StatsItem));
+    assert(total.peak_capacity == 40);
+    assert(total.elements_copied == 30 && total.elements_moved == 26);
+
+    bool found = false;
+    SimpleVectorStatsRegistry::Instance().ForEach(
+        [&found](const char* type_name, const SimpleVectorStats& type_stats) {
+            if (type_name == typeid(StatsItem).name()) {
+                found = type_stats.reallocations == 6;
+            }
+        });
+    assert(found);
+
+    SimpleVectorStatsRegistry::Instance().Reset();
+    assert(GetSimpleVectorTypeStats<StatsItem>().bytes_allocated == 0);
+#else
+    // Без SIMPLE_VECTOR_ENABLE_STATS счётчики не занимают места
+    static_assert(sizeof(SimpleVector<StatsItem>) == sizeof(StatsItem*) + 2 * sizeof(size_t));
+    SimpleVector<StatsItem> v(10);
+    v.Reserve(100);
+    assert(v.GetStats().reallocations == 0 && v.GetStats().bytes_allocated == 0);
+#endif
+    cout << "Done!"s << endl << endl;
+}
+
+// Сравнивает результаты операторов со стандартными алгоритмами на векторах,
+// отличающихся в одной позиции
+template <typename Type>
+void CheckComparisonAgainstStd(const vector<Type>& values) {
+    for (size_t size : {0, 1, 7, 15, 16, 17, 31, 32, 33, 64, 100}) {
+        for (size_t pos = 0; pos <= size; pos += 3) {
+            SimpleVector<Type> lhs;
+            lhs.Assign(values.begin(), values.begin() + size);
+            SimpleVector<Type> rhs = lhs;
+            if (pos < size) {
+                rhs[pos] = values[size + pos % 7];
+            }
+            const bool equal = std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+            const bool less = std::lexicographical_compare(lhs.begin(), lhs.end(),
+                                                           rhs.begin(), rhs.end());
+            const bool greater = std::lexicographical_compare(rhs.begin(), rhs.end(),
+                                                              lhs.begin(), lhs.end());
+            assert((lhs == rhs) == equal);
+            assert((lhs < rhs) == less);
+            assert((rhs < lhs) == greater);
+
+            SimpleVector<Type> prefix;
+            prefix.Assign(lhs.begin(), lhs.begin() + pos);
+            assert((prefix < lhs) == (pos < size));
+            assert(!(lhs < prefix));
+        }
+    }
+}
+
+void TestSimdComparison() {
+    cout << "Test SIMD comparison"s << endl;
+    vector<int> ints(200);
+    vector<uint8_t> bytes(200);
+    vector<int8_t> signed_bytes(200);
+    vector<double> doubles(200);
+    for (size_t i = 0; i < ints.size(); ++i) {
+        ints[i] = static_cast<int>(i * 7919 % 1000) - 500;
+        bytes[i] = static_cast<uint8_t>(i * 37);
+        signed_bytes[i] = static_cast<int8_t>(i * 37);
+        doubles[i] = static_cast<double>(ints[i]) / 3;
+    }
+    CheckComparisonAgainstStd(ints);
+    CheckComparisonAgainstStd(bytes);
+    CheckComparisonAgainstStd(signed_bytes);
+    CheckComparisonAgainstStd(doubles);
+
+    // Числа сравниваются как числа, а не как байты
+    const float nan = numeric_limits<float>::quiet_NaN();
+    SimpleVector<float> zeros(40, 0.0f);
+    SimpleVector<float> negative_zeros(40, -0.0f);
+    assert(zeros == negative_zeros);
+    assert(!(zeros < negative_zeros) && !(negative_zeros < zeros));
+
+    // NaN не равен самому себе и не упорядочен, поэтому порядок определяет
+    // следующий элемент
+    SimpleVector<float> with_nan(40, 1.0f);
+    with_nan[20] = nan;
+    SimpleVector<float> other_nan = with_nan;
+    assert(with_nan != other_nan);
+    other_nan[30] = 2.0f;
+    assert(with_nan < other_nan && !(other_nan < with_nan));
+
+    // Все ядра возвращают одинаковый индекс первого различия
+    vector<unsigned char> a(300, 1);
+    for (size_t pos : {0, 5, 16, 31, 32, 100, 299, 300}) {
+        vector<unsigned char> b = a;
+        if (pos < b.size()) {
+            b[pos] = 2;
+        }
+        assert(detail::MismatchBytesScalar(a.data(), b.data(), a.size()) == pos);
+        assert(detail::MismatchBytes(a.data(), b.data(), a.size()) == pos);
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD) && defined(__SSE2__)
+        assert(detail::MismatchBytesSse2(a.data(), b.data(), a.size()) == pos);
+#endif
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+        if (detail::CpuHasAvx2()) {
+            assert(detail::MismatchBytesAvx2(a.data(), b.data(), a.size()) == pos);
+        }
+#endif
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+template <typename Type>
+void CheckNumericKernels() {
+    for (size_t size : {0, 1, 3, 4, 7, 8, 15, 16, 31, 32, 33, 100, 1001}) {
+        SimpleVector<Type> x(size);
+        SimpleVector<Type> y(size);
+        for (size_t i = 0; i < size; ++i) {
+            x[i] = static_cast<Type>(static_cast<int>(i * 37 % 101) - 50) / 4;
+            y[i] = static_cast<Type>(static_cast<int>(i * 11 % 23) - 7);
+        }
+        // Все значения кратны 1/4 и малы, поэтому суммы точны при любом
+        // порядке сложения
+        assert(numeric::Sum(x) == accumulate(x.begin(), x.end(), Type{}));
+        assert(numeric::Dot(x, y) == inner_product(x.begin(), x.end(), y.begin(), Type{}));
+        assert(numeric::detail::SumScalar(x.begin(), size) == numeric::Sum(x));
+
+        if (size != 0) {
+            assert(numeric::Min(x) == *min_element(x.begin(), x.end()));
+            assert(numeric::Max(x) == *max_element(x.begin(), x.end()));
+            assert(numeric::ArgMin(x) ==
+                   static_cast<size_t>(min_element(x.begin(), x.end()) - x.begin()));
+            assert(numeric::ArgMax(x) ==
+                   static_cast<size_t>(max_element(x.begin(), x.end()) - x.begin()));
+        }
+
+        SimpleVector<Type> expected = y;
+        for (size_t i = 0; i < size; ++i) {
+            expected[i] += 2 * x[i];
+        }
+        numeric::Axpy(2, x, y);
+        assert(y == expected);
+
+        numeric::Scale(y, 3);
+        for (size_t i = 0; i < size; ++i) {
+            assert(y[i] == expected[i] * 3);
+        }
+    }
+}
+
+void TestNumericKernels() {
+    cout << "Test numeric kernels"s << endl;
+    CheckNumericKernels<float>();
+    CheckNumericKernels<double>();
+    CheckNumericKernels<int>();
+
+    SimpleVector<double> empty;
+    assert(numeric::Sum(empty) == 0.0);
+    assert(numeric::ArgMin(empty) == 0);
+    try {
+        numeric::Min(empty);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    SimpleVector<float> a(10, 1.0f);
+    SimpleVector<float> b(11, 1.0f);
+    try {
+        numeric::Dot(a, b);
+        assert(false);
+    } catch (const invalid_argument&) {
+    }
+
+    // Длинная сумма float с разными ядрами сходится к точному значению
+    SimpleVector<float> ones(1 << 20, 1.0f);
+    assert(numeric::Sum(ones) == static_cast<float>(1 << 20));
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAlignedStorage() {
+    cout << "Test aligned storage"s << endl;
+    static_assert(SimpleVector<char>::kAlignment == 1);
+    static_assert(AlignedSimpleVector<char, 32>::kAlignment == 32);
+
+    // Выравнивание сохраняется при каждом перевыделении
+    AlignedSimpleVector<char, 64> bytes;
+    assert(bytes.Data() == nullptr && bytes.IsAligned(64));
+    for (int i = 0; i < 1000; ++i) {
+        bytes.PushBack(static_cast<char>(i));
+        assert(bytes.IsAligned(64));
+    }
+    bytes.Reserve(5000);
+    assert(bytes.IsAligned(64));
+    bytes.Resize(7777);
+    assert(bytes.IsAligned(64));
+    bytes.Resize(3);
+    bytes.ShrinkToFit();
+    assert(bytes.IsAligned(64) && bytes.GetCapacity() == 3);
+    bytes.Insert(bytes.begin(), 'x');
+    assert(bytes.IsAligned(64) && bytes[0] == 'x');
+
+    AlignedSimpleVector<float, 32> floats(100, 0.5f);
+    assert(floats.IsAligned(32));
+    const AlignedSimpleVector<float, 32> copy = floats;
+    assert(copy.IsAligned(32) && copy == floats);
+    assert(numeric::Sum(copy) == 50.0f);
+
+    // Встроенный буфер выровнен так же, как буфер в куче
+    SmallSimpleVector<float, 3, AlignedAllocator<float, 64>> small;
+    small.PushBack(1.0f);
+    assert(small.IsInline() && small.IsAligned(64));
+    for (int i = 0; i < 10; ++i) {
+        small.PushBack(2.0f);
+    }
+    assert(!small.IsInline() && small.IsAligned(64));
+    cout << "Done!"s << endl << endl;
+}
+
+void TestParallelConstruction() {
+    cout << "Test parallel construction"s << endl;
+    ParallelPolicy policy;
+    policy.min_chunk_bytes = 4096;
+    policy.max_threads = 4;
+
+    // Внутренние границы кусков начинаются с новой страницы
+    const SimpleVector<int> ints(policy, 100000, 7);
+    const vector<size_t> bounds =
+        detail::ChunkBounds(policy, ints.Data(), ints.GetSize(), sizeof(int));
+    assert(bounds.size() == 5 && bounds.front() == 0 && bounds.back() == 100000);
+    for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+        assert(reinterpret_cast<uintptr_t>(ints.Data() + bounds[i]) % detail::kPageSize == 0);
+    }
+    assert(all_of(ints.begin(), ints.end(), [](int value) {
+        return value == 7;
+    }));
+
+    const SimpleVector<size_t> squares(policy, 50000, [](size_t i) {
+        return i * i;
+    });
+    for (size_t i = 0; i < squares.GetSize(); ++i) {
+        assert(squares[i] == i * i);
+    }
+
+    // Маленький буфер создаётся в вызывающем потоке
+    const SimpleVector<int> small(policy, 10, 1);
+    assert(detail::ChunkBounds(policy, small.Data(), 10, sizeof(int)).size() == 2);
+
+    SimpleVector<string> strings(policy, 3000, "parallel-construction-string"s);
+    const SimpleVector<string> strings_copy(policy, strings);
+    assert(strings_copy == strings);
+    strings.Reserve(policy, 10000);
+    assert(strings.GetCapacity() == 10000 && strings == strings_copy);
+
+    size_t sum = 0;
+    std::mutex sum_mutex;
+    ParallelFor(policy, squares.begin(), squares.end(),
+                [&sum, &sum_mutex](const size_t* first, const size_t* last) {
+                    const size_t chunk_sum = accumulate(first, last, size_t{0});
+                    lock_guard guard(sum_mutex);
+                    sum += chunk_sum;
+                });
+    assert(sum == accumulate(squares.begin(), squares.end(), size_t{0}));
+
+    // Исключение в одном куске разрушает элементы всех остальных. Счётчик
+    // ссылок shared_ptr атомарен и показывает, сколько копий осталось
+    const auto sentinel = make_shared<int>(1);
+    try {
+        const SimpleVector<shared_ptr<int>> copies(policy, 10000, [&sentinel](size_t i) {
+            if (i == 7777) {
+                throw runtime_error("generator failed");
+            }
+            return sentinel;
+        });
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    assert(sentinel.use_count() == 1);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestMmapStorage() {
+    cout << "Test mmap storage"s << endl;
+    constexpr size_t kReserveBytes = size_t{64} << 20;
+    const MmapAllocator<int> alloc(kReserveBytes);
+    MmapSimpleVector<int> v(alloc);
+    v.PushBack(0);
+    const int* data = v.Data();
+    assert(v.IsAligned(MmapAllocator<int>::kHugePageSize));
+
+    // Рост внутри зарезервированного диапазона не переносит элементы
+    for (int i = 1; i < 1000000; ++i) {
+        v.PushBack(i);
+    }
+    assert(v.Data() == data);
+    v.Resize(kReserveBytes / sizeof(int));
+    assert(v.Data() == data && v.GetCapacity() == kReserveBytes / sizeof(int));
+    assert(v[999999] == 999999 && v.GetSize() == kReserveBytes / sizeof(int));
+
+    // За пределами диапазона буфер перевыделяется
+    v.PushBack(-1);
+    assert(v.Data() != data && v.IsAligned(MmapAllocator<int>::kHugePageSize));
+    assert(v[999999] == 999999 && v[v.GetSize() - 1] == -1);
+
+    const MmapSimpleVector<int> copy = v;
+    assert(copy == v && copy.GetAllocator() == alloc);
+
+    MmapSimpleVector<string> strings(MmapAllocator<string>(1));
+    const vector<string> letters = {"a"s, "b"s, "c"s};
+    strings.InsertRange(strings.end(), letters.begin(), letters.end());
+    strings.Insert(strings.begin(), "z"s);
+    assert(strings.GetSize() == 4 && strings[0] == "z"s && strings[3] == "c"s);
+    cout << "Done!"s << endl << endl;
+}
+
+struct FileRecord {
+    uint32_t id;
+    double weight;
+};
+
+void TestVectorFile() {
+    cout << "Test vector file"s << endl;
+    const string path = (filesystem::temp_directory_path() / "simple_vector_test.bin").string();
+
+    SimpleVector<FileRecord> records;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        records.PushBack(FileRecord{i, i * 0.5});
+    }
+    SaveSimpleVector(path, records);
+
+    {
+        const MappedSimpleVector<FileRecord> mapped(path);
+        assert(mapped.GetSize() == records.GetSize() && mapped.Verify());
+        assert(reinterpret_cast<uintptr_t>(mapped.Data()) % alignof(FileRecord) == 0);
+        assert(mapped.GetHeader().data_offset % SimpleVectorFileHeader::kDataAlignment == 0);
+        assert(mapped[12345].id == 12345 && mapped.At(99999).weight == 99999 * 0.5);
+        assert(equal(mapped.begin(), mapped.end(), records.begin(), [](const auto& a, const auto& b) {
+            return a.id == b.id && a.weight == b.weight;
+        }));
+        try {
+            mapped.At(100000);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+    }
+
+    const SimpleVector<FileRecord> loaded = LoadSimpleVector<FileRecord>(path);
+    assert(loaded.GetSize() == records.GetSize() && loaded[777].id == 777);
+
+    // Тип другого размера и отсутствующий файл не открываются
+    try {
+        MappedSimpleVector<uint32_t> wrong(path);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    try {
+        MappedSimpleVector<FileRecord> missing(path + ".missing");
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+
+    // Испорченные данные обнаруживаются проверкой контрольной суммы
+    {
+        fstream file(path, ios::binary | ios::in | ios::out);
+        file.seekp(static_cast<streamoff>(MappedSimpleVector<FileRecord>(path).GetHeader().data_offset + 100));
+        file.put('\x7f');
+    }
+    assert(!MappedSimpleVector<FileRecord>(path).Verify());
+    try {
+        LoadSimpleVector<FileRecord>(path);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+
+    // Искажение старших битов двух слов тоже обнаруживается
+    SaveSimpleVector(path, records);
+    {
+        const uint64_t data_offset = MappedSimpleVector<FileRecord>(path).GetHeader().data_offset;
+        fstream file(path, ios::binary | ios::in | ios::out);
+        for (uint64_t offset : {data_offset + 800, data_offset + 8000}) {
+            uint64_t word = 0;
+            file.seekg(static_cast<streamoff>(offset));
+            file.read(reinterpret_cast<char*>(&word), sizeof(word));
+            word ^= uint64_t{1} << 63;
+            file.seekp(static_cast<streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(&word), sizeof(word));
+        }
+    }
+    try {
+        LoadSimpleVector<FileRecord>(path);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+
+    // Обрезанный файл отвергается сразу
+    filesystem::resize_file(path, 1000);
+    try {
+        MappedSimpleVector<FileRecord> truncated(path);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+
+    SaveSimpleVector(path, SimpleVector<int>());
+    const MappedSimpleVector<int> empty(path);
+    assert(empty.IsEmpty() && empty.Verify() && empty.begin() == empty.end());
+    filesystem::remove(path);
+    cout << "Done!"s << endl << endl;
+}
+
+// Функция, принимающая представление, работает с любым непрерывным массивом
+int SumView(SimpleVectorView<const int> view) {
+    return accumulate(view.begin(), view.end(), 0);
+}
+
+void TestSimpleVectorView() {
+    cout << "Test SimpleVectorView"s << endl;
+    SimpleVector<int> v = {1, 2, 3, 4, 5, 6};
+    const SimpleVector<int>& const_v = v;
+
+    SimpleVectorView view(v);
+    static_assert(is_same_v<decltype(view), SimpleVectorView<int>>);
+    SimpleVectorView const_view(const_v);
+    static_assert(is_same_v<decltype(const_view), SimpleVectorView<const int>>);
+    static_assert(!is_constructible_v<SimpleVectorView<int>, const SimpleVector<int>&>);
+    static_assert(is_convertible_v<SimpleVectorView<int>, SimpleVectorView<const int>>);
+    static_assert(!is_convertible_v<SimpleVectorView<const int>, SimpleVectorView<int>>);
+
+    assert(view.GetSize() == 6 && view.Data() == v.Data());
+    assert(SumView(v) == 21 && SumView(view) == 21);
+
+    // Изменения через представление видны в векторе
+    view[0] = 10;
+    assert(v[0] == 10);
+    for (int& item : view.Subview(4)) {
+        item *= 2;
+    }
+    assert(v[4] == 10 && v[5] == 12);
+
+    // Срезы не копируют данные
+    const SimpleVectorView<const int> middle = const_view.Subview(1, 3);
+    assert(middle.GetSize() == 3 && middle.Data() == v.Data() + 1 && middle[0] == 2);
+    assert(const_view.Subview(2, 100).GetSize() == 4);
+    assert(const_view.Subview(6).IsEmpty());
+    assert(const_view.First(2).GetSize() == 2 && const_view.Last(2)[0] == 10);
+    try {
+        const_view.Subview(7);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    try {
+        middle.At(3);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // Сравнение по содержимому, независимо от константности
+    SimpleVector<int> other = {2, 3, 4};
+    assert(middle == SimpleVectorView(other));
+    other[2] = 5;
+    assert(middle != SimpleVectorView(other) && middle < SimpleVectorView(other));
+    assert(middle.First(2) < middle && middle >= middle.First(2));
+
+    // Представление сырой памяти, малого вектора и отображённого файла
+    int raw[] = {7, 8, 9};
+    assert(SumView(SimpleVectorView<const int>(raw, 3)) == 24);
+    assert(SumView(SimpleVectorView<const int>(begin(raw), end(raw))) == 24);
+    SmallSimpleVector<int, 4> small = {1, 1};
+    assert(SumView(small) == 2);
+
+    const string path = (filesystem::temp_directory_path() / "simple_vector_view.bin").string();
+    SaveSimpleVector(path, v);
+    {
+        const MappedSimpleVector<int> mapped(path);
+        assert(mapped.View() == const_view && SumView(mapped) == SumView(v));
+        assert(mapped.View().Subview(1, 2) == const_view.Subview(1, 2));
+    }
+    filesystem::remove(path);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestCowSimpleVector() {
+    cout << "Test CowSimpleVector"s << endl;
+    // Копия обычного вектора получает ёмкость, равную размеру, и растёт дальше
+    {
+        SimpleVector<int> source(10, 1);
+        source.Reserve(100);
+        SimpleVector<int> copy(source);
+        assert(copy.GetSize() == 10 && copy.GetCapacity() == 10);
+        copy.PushBack(2);
+        assert(copy.GetSize() == 11 && copy[10] == 2);
+    }
+
+    CowSimpleVector<int> config = {1, 2, 3, 4};
+    assert(!config.IsShared());
+
+    // Копирование не копирует элементы
+    CowSimpleVector<int> snapshot = config;
+    assert(snapshot.IsShared() && config.IsShared());
+    assert(snapshot.Data() == config.Data() && snapshot == config);
+
+    // Константный доступ не отсоединяет
+    const CowSimpleVector<int>& const_snapshot = snapshot;
+    assert(const_snapshot[1] == 2 && const_snapshot.At(3) == 4);
+    assert(SumView(const_snapshot) == 10 && snapshot.IsShared());
+
+    // Первое изменение копирует буфер, оригинал не меняется
+    snapshot[0] = 10;
+    assert(!snapshot.IsShared() && !config.IsShared());
+    assert(snapshot.Data() != config.Data());
+    assert(config[0] == 1 && snapshot[0] == 10 && config < snapshot);
+
+    // Изменения собственного буфера не копируют его
+    const int* own = snapshot.Data();
+    snapshot[1] = 20;
+    assert(snapshot.Data() == own);
+
+    // Итератор, полученный до отсоединения, указывает ту же позицию
+    CowSimpleVector<int> inserted = config;
+    const int* pos = as_const(inserted).begin() + 2;
+    inserted.Insert(pos, 42);
+    assert(inserted.GetSize() == 5 && inserted[2] == 42 && config.GetSize() == 4);
+
+    CowSimpleVector<int> erased = config;
+    erased.Erase(as_const(erased).begin(), as_const(erased).begin() + 2);
+    assert(erased.GetSize() == 2 && erased[0] == 3 && config[0] == 1);
+
+    CowSimpleVector<int> pushed = config;
+    pushed.PushBack(5);
+    pushed.Resize(7);
+    assert(pushed.GetSize() == 7 && pushed[4] == 5 && pushed[6] == 0 && config.GetSize() == 4);
+
+    CowSimpleVector<int> cleared = config;
+    cleared.Clear();
+    assert(cleared.IsEmpty() && config.GetSize() == 4 && !config.IsShared());
+
+    // Недопустимый индекс не вызывает отсоединения
+    CowSimpleVector<int> checked = config;
+    try {
+        checked.At(4);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    assert(checked.IsShared());
+
+    // Пустой вектор по умолчанию
+    CowSimpleVector<int> empty;
+    assert(empty.IsEmpty() && empty.begin() == empty.end());
+    empty.PushBack(1);
+    assert(empty.GetSize() == 1);
+
+    // Раздача снимка потокам: счётчик ссылок атомарный
+    CowSimpleVector<int> large(SimpleVector<int>(100000, 1));
+    vector<thread> workers;
+    vector<int> sums(4);
+    for (size_t i = 0; i < sums.size(); ++i) {
+        workers.emplace_back([copy = large, &sum = sums[i]]() mutable {
+            sum = SumView(as_const(copy));
+            // Каждый поток отсоединяется от общего буфера независимо
+            copy[0] = 0;
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    assert(all_of(sums.begin(), sums.end(), [](int sum) { return sum == 100000; }));
+    assert(!large.IsShared() && large[0] == 1);
+
+    // Поток отпускает копию после чтения, и владелец пишет в буфер на месте
+    CowSimpleVector<int> owner(SimpleVector<int>(1000, 1));
+    const int* owner_data = owner.Data();
+    atomic<bool> released{false};
+    int reader_sum = 0;
+    thread reader([copy = owner, &released, &reader_sum]() mutable {
+        reader_sum = SumView(as_const(copy));
+        copy = CowSimpleVector<int>();
+        released.store(true, memory_order_relaxed);
+    });
+    while (!released.load(memory_order_relaxed)) {
+        this_thread::yield();
+    }
+    assert(!owner.IsShared());
+    owner[0] = 2;
+    reader.join();
+    assert(reader_sum == 1000 && owner.Data() == owner_data && owner[0] == 2);
+    cout << "Done!"s << endl << endl;
+}
+
+// Число выделений, после которого LimitedAllocator выбрасывает std::bad_alloc.
+// Общее для всех типов элементов
+inline int limited_allocations_left = numeric_limits<int>::max();
+
+// Аллокатор с маленьким max_size для проверки переполнения и нехватки памяти
+template <typename Type>
+struct LimitedAllocator : allocator<Type> {
+    static constexpr size_t kMaxSize = 100;
+
+    template <typename Other>
+    struct rebind {
+        using other = LimitedAllocator<Other>;
+    };
+
+    LimitedAllocator() noexcept = default;
+
+    template <typename Other>
+    LimitedAllocator(const LimitedAllocator<Other>&) noexcept {
+    }
+
+    Type* allocate(size_t count) {
+        if (limited_allocations_left == 0) {
+            throw bad_alloc();
+        }
+        --limited_allocations_left;
+        return allocator<Type>::allocate(count);
+    }
+
+    size_t max_size() const noexcept {
+        return kMaxSize;
+    }
+};
+
+void TestConcurrentSimpleVector() {
+    cout << "Test ConcurrentSimpleVector"s << endl;
+    {
+        ConcurrentSimpleVector<int> v;
+        assert(v.IsEmpty() && !v.IsReady(0));
+        int& first = v.PushBack(1);
+        // Рост не перемещает уже созданные элементы
+        for (int i = 2; i <= 1000; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(&first == &v[0] && v.GetSize() == 1000 && v[999] == 1000);
+        assert(v.IsReady(999) && !v.IsReady(1000));
+        try {
+            v.At(1000);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+        const SimpleVector<int> flat = v.ToSimpleVector();
+        assert(flat.GetSize() == 1000 && flat[0] == 1 && flat[999] == 1000);
+    }
+
+    // Одновременное добавление из нескольких потоков
+    {
+        constexpr int kThreads = 4;
+        constexpr int kPerThread = 20000;
+        ConcurrentSimpleVector<int> v;
+        v.Reserve(kThreads * kPerThread / 2);
+        vector<thread> workers;
+        for (int t = 0; t < kThreads; ++t) {
+            workers.emplace_back([&v, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    const int& item = v.PushBack(t * kPerThread + i);
+                    assert(item == t * kPerThread + i);
+                }
+            });
+        }
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        assert(v.GetSize() == size_t{kThreads * kPerThread});
+        vector<bool> seen(kThreads * kPerThread);
+        for (size_t i = 0; i < v.GetSize(); ++i) {
+            seen[v.At(i)] = true;
+        }
+        assert(all_of(seen.begin(), seen.end(), [](bool value) { return value; }));
+    }
+
+    // Место элемента, конструктор которого выбросил исключение, не становится
+    // готовым, а ToSimpleVector пропускает его
+    {
+        ConcurrentSimpleVector<Fragile> v;
+        const Fragile source(7);
+        v.PushBack(source);
+        Fragile::copies_left = 0;
+        try {
+            v.PushBack(source);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        Fragile::copies_left = numeric_limits<int>::max();
+        v.PushBack(source);
+        assert(v.GetSize() == 3 && !v.IsReady(1) && v.IsReady(2) && v[2].GetValue() == 7);
+        assert(v.ToSimpleVector().GetSize() == 2);
+    }
+
+    // Добавление сверх GetMaxSize не захватывает место
+    {
+        ConcurrentSimpleVector<int, LimitedAllocator<int>> v;
+        assert(v.GetMaxSize() == LimitedAllocator<int>::kMaxSize);
+        for (size_t i = 0; i < v.GetMaxSize(); ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        try {
+            v.PushBack(-1);
+            assert(false);
+        } catch (const length_error&) {
+        }
+        assert(v.GetSize() == v.GetMaxSize() && v.IsReady(v.GetSize() - 1));
+    }
+
+    // Место, сегмент которого не удалось выделить, помечается неудавшимся
+    {
+        ConcurrentSimpleVector<int, LimitedAllocator<int>> v;
+        for (int i = 0; i < int{ConcurrentSimpleVector<int>::kFirstSegmentSize}; ++i) {
+            v.PushBack(i);
+        }
+        // Массив состояний второго сегмента выделяется, буфер элементов — нет
+        limited_allocations_left = 1;
+        try {
+            v.PushBack(-1);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        limited_allocations_left = numeric_limits<int>::max();
+        v.PushBack(65);
+        assert(v.GetSize() == 66 && !v.IsReady(64) && v.IsReady(65) && v[65] == 65);
+        assert(v.ToSimpleVector().GetSize() == 65);
+
+        // Без массива состояний неудавшимся становится весь сегмент
+        ConcurrentSimpleVector<int, LimitedAllocator<int>> failed;
+        limited_allocations_left = 0;
+        try {
+            failed.PushBack(0);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        limited_allocations_left = numeric_limits<int>::max();
+        try {
+            failed.PushBack(1);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        assert(failed.GetSize() == 2 && !failed.IsReady(0) && !failed.IsReady(1));
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestThreadLocalAppender() {
+    cout << "Test ThreadLocalAppender"s << endl;
+    // Перенос нескольких векторов в конец одного
+    {
+        SimpleVector<int> target = {1, 2};
+        SimpleVector<int> a = {3, 4, 5};
+        SimpleVector<int> empty;
+        SimpleVector<int> b = {6};
+        SimpleVector<int>* sources[] = {&a, &empty, &b};
+        const ParallelPolicy policy{sizeof(int), 4};
+        target.AppendMoved(policy, sources, 3);
+        assert((target == SimpleVector<int>{1, 2, 3, 4, 5, 6}));
+        assert(a.IsEmpty() && b.IsEmpty() && a.GetCapacity() == 3);
+    }
+    {
+        // Если копирование не удалось, векторы не меняются
+        SimpleVector<Fragile> target;
+        SimpleVector<Fragile> source;
+        for (int i = 0; i < 10; ++i) {
+            source.EmplaceBack(i);
+        }
+        SimpleVector<Fragile>* sources[] = {&source};
+        Fragile::copies_left = 5;
+        try {
+            target.AppendMoved(ParallelPolicy{}, sources, 1);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        Fragile::copies_left = numeric_limits<int>::max();
+        assert(target.IsEmpty() && source.GetSize() == 10 && source[9].GetValue() == 9);
+    }
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 10000;
+    ThreadLocalAppender<int> appender;
+    SimpleVector<int> merged;
+    for (int round = 0; round < 2; ++round) {
+        vector<thread> workers;
+        for (int t = 0; t < kThreads; ++t) {
+            workers.emplace_back([&appender, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    appender.PushBack(t * kPerThread + i);
+                }
+            });
+        }
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        assert(appender.GetSize() == size_t{kThreads * kPerThread});
+        appender.MergeInto(merged, ParallelPolicy{4096, kThreads});
+        assert(appender.GetSize() == 0);
+    }
+    assert(merged.GetSize() == size_t{2 * kThreads * kPerThread});
+    vector<int> counts(kThreads * kPerThread);
+    for (int item : merged) {
+        ++counts[item];
+    }
+    assert(all_of(counts.begin(), counts.end(), [](int count) { return count == 2; }));
+
+    // Элементы одного потока сохраняют порядок добавления
+    ThreadLocalAppender<string> local;
+    local.PushBack("a"s);
+    local.EmplaceBack("b");
+    assert(local.GetShardCount() == 1 && &local.Local() == &local.Local());
+    const SimpleVector<string> strings = local.Merge();
+    assert(strings.GetSize() == 2 && strings[0] == "a"s && strings[1] == "b"s);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestParallelAlgorithms() {
+    cout << "Test parallel algorithms"s << endl;
+    const ParallelPolicy policy{4096, 4};
+    mt19937_64 random(42);
+
+    // Поразрядная сортировка целых со знаком и без
+    {
+        SimpleVector<uint64_t> keys;
+        SimpleVector<int32_t> signed_keys;
+        for (int i = 0; i < 100000; ++i) {
+            keys.PushBack(random());
+            signed_keys.PushBack(static_cast<int32_t>(random()));
+        }
+        // Свободной вместимости хватает на вспомогательный буфер
+        keys.Reserve(keys.GetSize() * 2);
+        const uint64_t* data = keys.Data();
+        vector<uint64_t> expected(keys.begin(), keys.end());
+        sort(expected.begin(), expected.end());
+        ParallelSort(policy, keys);
+        assert(keys.Data() == data && equal(keys.begin(), keys.end(), expected.begin()));
+
+        RadixSort(policy, signed_keys);
+        assert(is_sorted(signed_keys.begin(), signed_keys.end()));
+        assert(signed_keys[0] < 0 && signed_keys[signed_keys.GetSize() - 1] > 0);
+    }
+
+    // Сортировка с компаратором и устойчивая сортировка пар
+    {
+        SimpleVector<pair<uint32_t, uint32_t>> pairs;
+        for (uint32_t i = 0; i < 50000; ++i) {
+            pairs.PushBack({static_cast<uint32_t>(random() % 100), i});
+        }
+        SimpleVector<pair<uint32_t, uint32_t>> unstable = pairs;
+        ParallelSort(policy, unstable, greater<>());
+        assert(is_sorted(unstable.begin(), unstable.end(), greater<>()));
+
+        ParallelStableSort(policy, pairs, [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        assert(is_sorted(pairs.begin(), pairs.end()));
+    }
+
+    // Элементы, которые нельзя копировать побайтово, сливаются на месте
+    {
+        SimpleVector<string> words;
+        for (int i = 0; i < 5000; ++i) {
+            words.PushBack(to_string(random() % 1000));
+        }
+        ParallelStableSort(ParallelPolicy{1024, 4}, words);
+        assert(is_sorted(words.begin(), words.end()));
+
+        const size_t size = ParallelUnique(ParallelPolicy{1024, 4}, words);
+        assert(size == words.GetSize() && size <= 1000);
+        assert(adjacent_find(words.begin(), words.end()) == words.end());
+    }
+
+    // Группы повторов, пересекающие границы кусков, сворачиваются в один элемент
+    {
+        SimpleVector<int> values;
+        for (int i = 0; i < 200000; ++i) {
+            values.PushBack(i / 3000);
+        }
+        const size_t capacity = values.GetCapacity();
+        assert(ParallelUnique(policy, values) == 67);
+        assert(values.GetCapacity() == capacity);
+        for (int i = 0; i < 67; ++i) {
+            assert(values[i] == i);
+        }
+
+        SimpleVector<int> empty;
+        ParallelSort(policy, empty);
+        assert(ParallelUnique(policy, empty) == 0);
+        SimpleVector<int> small = {3, 1, 2, 1};
+        ParallelSort(policy, small);
+        assert((small == SimpleVector<int>{1, 1, 2, 3}));
+        ParallelUnique(policy, small);
+        assert((small == SimpleVector<int>{1, 2, 3}));
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSoaSimpleVector() {
+    cout << "Test SoaSimpleVector"s << endl;
+    // Событие: время, значение, тип
+    SoaSimpleVector<uint64_t, double, uint8_t> events;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        events.PushBack({i, i * 0.5, static_cast<uint8_t>(i % 4)});
+    }
+    assert(events.GetSize() == 1000 && events.GetCapacity() >= 1000);
+
+    // Столбцы лежат подряд и выровнены по кэш-линии
+    const SimpleVectorView<const double> values = as_const(events).Column<1>();
+    assert(values.GetSize() == 1000 && values[10] == 5.0);
+    assert(reinterpret_cast<uintptr_t>(values.Data()) % 64 == 0);
+    assert(accumulate(values.begin(), values.end(), 0.0) == 0.5 * 999 * 1000 / 2);
+    for (uint64_t& time : events.Column<0>()) {
+        time *= 2;
+    }
+    assert(events.Get<0>(7) == 14);
+
+    // Итератор возвращает кортеж ссылок на поля
+    size_t odd_type = 0;
+    for (auto [time, value, type] : as_const(events)) {
+        odd_type += type % 2;
+        assert(static_cast<double>(time) == value * 4);
+    }
+    assert(odd_type == 500);
+    for (auto [time, value, type] : events) {
+        value = static_cast<double>(type);
+    }
+    assert(events.Get<1>(5) == 1.0);
+    auto row = events[3];
+    get<2>(row) = 42;
+    assert(events.Get<2>(3) == 42 && get<0>(events.At(3)) == 6);
+    try {
+        events.At(1000);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    const auto it = events.begin() + 10;
+    assert(it - events.begin() == 10 && get<0>(*it) == 20 && get<0>(it[1]) == 22);
+    SoaSimpleVector<uint64_t, double, uint8_t>::ConstIterator const_it = it;
+    assert(const_it == it && distance(events.cbegin(), events.cend()) == 1000);
+
+    // Копия, изменение размера и удаление
+    SoaSimpleVector<uint64_t, double, uint8_t> copy = events;
+    assert(copy == events && copy.GetCapacity() == 1000);
+    copy.PopBack();
+    copy.Resize(1002);
+    assert(copy != events && copy.GetSize() == 1002 && copy.Get<1>(1001) == 0.0);
+    copy.Clear();
+    assert(copy.IsEmpty());
+
+    // Исключение при добавлении записи не меняет вектор
+    SoaSimpleVector<string, Fragile> fragile;
+    fragile.EmplaceBack("a"s, Fragile(1));
+    const Fragile source(2);
+    Fragile::copies_left = 0;
+    try {
+        fragile.EmplaceBack("b"s, source);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    Fragile::copies_left = numeric_limits<int>::max();
+    assert(fragile.GetSize() == 1 && fragile.Get<0>(0) == "a"s);
+    fragile.Reserve(10);
+    assert(fragile.GetCapacity() == 10 && fragile.Get<1>(0).GetValue() == 1);
+
+    // Аргументы могут ссылаться на поля вектора, который перевыделяет память
+    SoaSimpleVector<string, int> aliased;
+    aliased.EmplaceBack(string(40, 'x'), 1);
+    assert(aliased.GetSize() == aliased.GetCapacity());
+    aliased.EmplaceBack(get<0>(aliased[0]), 2);
+    assert(aliased.GetCapacity() > 1 && aliased.Get<0>(1) == string(40, 'x'));
+    aliased.PushBack(aliased[1]);
+    assert(aliased.Get<0>(2) == string(40, 'x') && aliased.Get<1>(2) == 2);
+    assert(aliased.Get<0>(0) == string(40, 'x'));
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSegmentedSimpleVector() {
+    cout << "Test SegmentedSimpleVector"s << endl;
+    static_assert(SegmentedSimpleVector<int>::kChunkSize == 1024);
+    static_assert(SegmentedSimpleVector<char[3000]>::kChunkSize == 1);
+
+    SegmentedSimpleVector<int, 16> v;
+    assert(v.IsEmpty() && v.GetCapacity() == 0);
+    v.PushBack(0);
+    const int* first = &v[0];
+    auto it = v.begin();
+    // Рост добавляет куски и не переносит элементы
+    for (int i = 1; i < 1000; ++i) {
+        v.PushBack(i);
+    }
+    assert(&v[0] == first && *it == 0 && it[999] == 999);
+    assert(v.GetSize() == 1000 && v.GetCapacity() == 1008 && v.GetChunkCount() == 63);
+    assert(v.ChunkView(1)[0] == 16 && v.ChunkView(62).GetSize() == 8);
+    assert(accumulate(v.begin(), v.end(), 0) == 999 * 1000 / 2);
+    assert(v.end() - v.begin() == 1000 && is_sorted(v.cbegin(), v.cend()));
+    try {
+        v.At(1000);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // Итераторы произвольного доступа подходят для алгоритмов стандартной
+    // библиотеки
+    reverse(v.begin(), v.end());
+    assert(v[0] == 999 && v[999] == 0);
+    sort(v.begin(), v.end());
+    assert(*lower_bound(v.begin(), v.end(), 500) == 500);
+
+    SegmentedSimpleVector<int, 16> copy = v;
+    assert(copy == v && copy.GetCapacity() == 1008);
+    copy.PopBack();
+    assert(copy != v && copy < v);
+    copy.Resize(10);
+    assert(copy.GetSize() == 10 && copy.GetCapacity() == 1008);
+    copy.ShrinkToFit();
+    assert(copy.GetCapacity() == 16);
+    copy.Resize(20);
+    assert(copy[19] == 0 && copy.GetCapacity() == 32);
+    copy.Clear(true);
+    assert(copy.IsEmpty() && copy.GetCapacity() == 0);
+
+    SegmentedSimpleVector<string, 4> strings = {"a"s, "b"s, "c"s, "d"s, "e"s};
+    SegmentedSimpleVector<string, 4> moved = move(strings);
+    assert(strings.IsEmpty() && moved.GetSize() == 5 && moved.begin()->size() == 1);
+    moved.Reserve(100);
+    assert(moved.GetCapacity() == 100 && moved[4] == "e"s);
+
+    SegmentedSimpleVector<X> noncopyable;
+    noncopyable.EmplaceBack(7);
+    noncopyable.PushBack(X(8));
+    assert(noncopyable[1].GetX() == 8);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestDequeSimpleVector() {
+    cout << "Test DequeSimpleVector"s << endl;
+    DequeSimpleVector<int> v;
+    for (int i = 0; i < 100; ++i) {
+        v.PushBack(i);
+        v.PushFront(-i - 1);
+    }
+    assert(v.GetSize() == 200 && v[0] == -100 && v[199] == 99);
+    assert(is_sorted(v.begin(), v.end()) && SumView(v) == -100);
+
+    // Скользящее окно: вместимость перестаёт расти, элементы переносятся внутри
+    // буфера
+    DequeSimpleVector<int> window;
+    for (int i = 0; i < 64; ++i) {
+        window.PushBack(i);
+    }
+    size_t capacity = 0;
+    for (int i = 64; i < 100000; ++i) {
+        window.PopFront();
+        window.PushBack(i);
+        if (i == 1000) {
+            capacity = window.GetCapacity();
+        }
+    }
+    assert(window.GetCapacity() == capacity && window.GetSize() == 64);
+    assert(window[0] == 100000 - 64 && window[63] == 99999);
+
+    // Элементы без noexcept-перемещения переносятся в новый буфер той же
+    // вместимости, и окно тоже перестаёт расти
+    DequeSimpleVector<Fragile> fragile_window;
+    for (int i = 0; i < 4; ++i) {
+        fragile_window.PushBack(Fragile(i));
+    }
+    for (int i = 4; i < 100000; ++i) {
+        fragile_window.PopFront();
+        fragile_window.PushBack(Fragile(i));
+        if (i == 1000) {
+            capacity = fragile_window.GetCapacity();
+        }
+    }
+    assert(fragile_window.GetCapacity() == capacity && fragile_window.GetSize() == 4);
+    assert(fragile_window[0].GetValue() == 100000 - 4 && fragile_window[3].GetValue() == 99999);
+
+    // Вставка и удаление сдвигают более короткую часть
+    DequeSimpleVector<int> shifted = {0, 1, 2, 3, 4, 5, 6, 7};
+    shifted.Reserve(32);
+    // Первая вставка в начало переносит элементы к середине буфера
+    shifted.PushFront(-1);
+    shifted.PopFront();
+    assert(shifted.GetCapacity() == 32 && shifted.GetFrontSlack() > 0 && shifted.GetBackSlack() > 0);
+    const int* last = &shifted[7];
+    shifted.Insert(shifted.begin() + 1, 100);
+    assert(&shifted[8] == last && shifted[1] == 100 && shifted[2] == 1);
+    const int* first = shifted.begin();
+    shifted.Insert(shifted.end() - 1, 200);
+    assert(shifted.begin() == first && shifted[8] == 200 && shifted[9] == 7);
+    shifted.Erase(shifted.begin() + 1);
+    assert(shifted.begin() == first + 1 && shifted[1] == 1);
+    shifted.Erase(shifted.end() - 3, shifted.end() - 1);
+    assert((shifted == DequeSimpleVector<int>{0, 1, 2, 3, 4, 5, 7}));
+    shifted.Erase(shifted.begin(), shifted.begin() + 2);
+    assert(shifted[0] == 2 && shifted.GetSize() == 5);
+
+    // Элементы со сложным перемещением
+    DequeSimpleVector<string> strings;
+    for (int i = 0; i < 50; ++i) {
+        strings.PushFront(to_string(i));
+        strings.EmplaceBack(3, 'a' + i % 26);
+    }
+    strings.Insert(strings.begin() + 10, "middle"s);
+    assert(strings[10] == "middle"s && strings[0] == "49"s && strings[100] == "xxx"s);
+    strings.Erase(strings.begin() + 10);
+    strings.PopBack();
+    strings.PopFront();
+    assert(strings.GetSize() == 98 && strings[0] == "48"s && strings[97] == "www"s);
+    // Значение может ссылаться на элемент самого вектора
+    strings.PushFront(strings[97]);
+    strings.PushBack(strings[1]);
+    assert(strings[0] == "www"s && strings[99] == "48"s);
+
+    DequeSimpleVector<string> copy = strings;
+    assert(copy == strings && copy.GetCapacity() == copy.GetSize());
+    copy.Resize(120);
+    assert(copy[119].empty() && copy > strings);
+    copy.Clear();
+    assert(copy.IsEmpty() && copy.GetFrontSlack() == 0);
+    try {
+        copy.At(0);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    DequeSimpleVector<X> noncopyable;
+    noncopyable.EmplaceFront(1);
+    noncopyable.PushBack(X(2));
+    noncopyable.PushFront(X(3));
+    assert(noncopyable[0].GetX() == 3 && noncopyable[2].GetX() == 2);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestRingBuffer() {
+    cout << "Test RingBuffer"s << endl;
+    RingBuffer<int> window(5);
+    assert(window.GetCapacity() == 8 && window.IsEmpty());
+    for (int i = 0; i < 8; ++i) {
+        window.PushBack(i);
+    }
+    assert(window.IsFull() && window.Front() == 0 && window.Back() == 7);
+    // Заполненный буфер вытесняет самые старые элементы
+    for (int i = 8; i < 13; ++i) {
+        window.PushBack(i);
+    }
+    assert(window.GetSize() == 8 && window[0] == 5 && window[7] == 12);
+    assert(equal(window.begin(), window.end(), vector<int>{5, 6, 7, 8, 9, 10, 11, 12}.begin()));
+    auto [head, tail] = window.GetSegments();
+    assert(head.GetSize() == 3 && tail.GetSize() == 5 && head[0] == 5 && tail[0] == 8);
+    assert(SumView(head) + SumView(tail) == accumulate(window.begin(), window.end(), 0));
+    window.PopFront();
+    window.PopBack();
+    assert(window.GetSize() == 6 && window.Front() == 6 && window.Back() == 11);
+    try {
+        window.At(6);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    try {
+        RingBuffer<int> empty(0);
+        assert(false);
+    } catch (const invalid_argument&) {
+    }
+
+    // Значение может ссылаться на вытесняемый элемент
+    RingBuffer<string> strings(2);
+    strings.PushBack("first"s);
+    strings.EmplaceBack(3, 'a');
+    strings.PushBack(strings.Front());
+    assert(strings[0] == "aaa"s && strings[1] == "first"s);
+    RingBuffer<string> copy = strings;
+    RingBuffer<string> moved = std::move(strings);
+    assert(equal(copy.begin(), copy.end(), moved.begin(), moved.end()));
+    copy.Clear();
+    assert(copy.IsEmpty() && copy.GetCapacity() == 2);
+    // Перемещённый буфер не имеет вместимости и не принимает элементы
+    assert(strings.GetCapacity() == 0 && strings.IsEmpty() && strings.begin() == strings.end());
+    try {
+        strings.PushBack("lost"s);
+        assert(false);
+    } catch (const logic_error&) {
+    }
+    strings = copy;
+    strings.PushBack("again"s);
+    assert(strings.GetCapacity() == 2 && strings.Front() == "again"s);
+
+    // Один производитель и один потребитель
+    SpscRingBuffer<uint64_t> queue(1000);
+    assert(queue.GetCapacity() == 1024);
+    const uint64_t count = 200000;
+    thread producer([&queue, count] {
+        for (uint64_t i = 0; i < count; ++i) {
+            while (!queue.TryPush(i)) {
+                this_thread::yield();
+            }
+        }
+    });
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    while (expected < count) {
+        if (queue.TryPop(value)) {
+            assert(value == expected);
+            ++expected;
+        } else {
+            this_thread::yield();
+        }
+    }
+    producer.join();
+    assert(queue.IsEmpty() && !queue.TryPop(value));
+
+    // Заполненная очередь не вытесняет элементы, оставшиеся разрушаются
+    // вместе с ней
+    SpscRingBuffer<string> names(2);
+    assert(names.TryPush("a"s) && names.TryEmplace(2, 'b') && !names.TryPush("c"s));
+    string name;
+    assert(names.TryPop(name) && name == "a"s && names.GetSize() == 1);
+    cout << "Done!"s << endl << endl;
+}
+
+#if defined(SIMPLE_VECTOR_HAS_CONSTEXPR)
+// Таблица квадратов, построенная во время компиляции
+constexpr StaticVector<int, 16> MakeSquares() {
+    StaticVector<int, 16> squares;
+    for (int i = 0; i < 16; ++i) {
+        squares.PushBack(i * i);
+    }
+    return squares;
+}
+
+constexpr int SumOfSquares(size_t count) {
+    SimpleVector<int> v;
+    for (size_t i = 0; i < count; ++i) {
+        v.PushBack(static_cast<int>(i * i));
+    }
+    v.Insert(v.begin(), -1);
+    v.Erase(v.begin());
+    SimpleVector<int> copy = v;
+    int sum = 0;
+    for (int item : copy) {
+        sum += item;
+    }
+    return copy == v ? sum : -1;
+}
+
+constexpr StaticVector<int, 16> kSquares = MakeSquares();
+static_assert(kSquares.GetSize() == 16 && kSquares[15] == 225);
+static_assert(SumOfSquares(10) == 285);
+#endif
+
+void TestStaticVector() {
+    cout << "Test StaticVector"s << endl;
+    static_assert(StaticVector<int, 8>::GetCapacity() == 8);
+    // Размер хранится в наименьшем подходящем типе
+    static_assert(sizeof(StaticVector<char, 15>) == 16);
+
+    StaticVector<int, 8> v = {1, 2, 3};
+    v.PushBack(4);
+    v.Insert(v.begin(), 0);
+    v.EmplaceBack(5);
+    assert((v == StaticVector<int, 8>{0, 1, 2, 3, 4, 5}));
+    v.Erase(v.begin() + 1, v.begin() + 3);
+    v.Erase(v.begin());
+    assert((v == StaticVector<int, 8>{3, 4, 5}) && v.GetSize() == 3);
+    const int extra[] = {6, 7, 8, 9, 10};
+    v.Append(begin(extra), end(extra));
+    assert(v.IsFull() && v[7] == 10);
+    try {
+        v.PushBack(11);
+        assert(false);
+    } catch (const length_error&) {
+    }
+    assert(v.GetSize() == 8);
+    try {
+        v.Reserve(9);
+        assert(false);
+    } catch (const length_error&) {
+    }
+    try {
+        v.At(8);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    v.Resize(2);
+    assert((v == StaticVector<int, 8>{3, 4}));
+    v.Resize(4);
+    assert((v[3] == 0 && v < StaticVector<int, 8>{3, 5}));
+
+    // Элементы со сложным временем жизни
+    StaticVector<string, 4> strings(2, "ab"s);
+    strings.Insert(strings.begin() + 1, "middle"s);
+    strings.PushBack(strings[0]);
+    StaticVector<string, 4> other = {"x"s};
+    strings.swap(other);
+    assert(strings.GetSize() == 1 && other.GetSize() == 4 && other[1] == "middle"s);
+    StaticVector<string, 4> moved = std::move(other);
+    assert(other.IsEmpty() && moved[3] == "ab"s);
+    other = moved;
+    assert(other == moved);
+
+    StaticVector<X, 3> xs;
+    xs.EmplaceBack(1);
+    xs.PushBack(X(2));
+    xs.Insert(xs.begin(), X(0));
+    StaticVector<X, 3> xs_moved = std::move(xs);
+    assert(xs.IsEmpty() && xs_moved[0].GetX() == 0 && xs_moved[2].GetX() == 2);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestPrefetch() {
+    cout << "Test Prefetch"s << endl;
+    static_assert(DefaultPrefetchDistance<int>() == 32);
+    static_assert(DefaultPrefetchDistance<array<char, 64>>() == 16);
+    static_assert(DefaultPrefetchDistance<array<char, 4096>>() == 4);
+    static_assert(DefaultPrefetchDistance<void>() == 32);
+
+    // Обход массива указателей в перемешанном порядке
+    SimpleVector<int> values(1000);
+    iota(values.begin(), values.end(), 0);
+    SimpleVector<int*> pointers;
+    for (int& value : values) {
+        pointers.PushBack(&value);
+    }
+    shuffle(pointers.begin(), pointers.end(), mt19937(42));
+    for (size_t distance : {size_t{0}, size_t{1}, size_t{7}, size_t{5000}}) {
+        long long sum = 0;
+        ForEachPrefetched(pointers, [&sum](int* value) { sum += *value; }, distance);
+        assert(sum == 999 * 1000 / 2);
+    }
+    SimpleVectorView<int* const> tail = SimpleVectorView<int* const>(pointers).Last(10);
+    int visited = 0;
+    ForEachPrefetched(tail.begin(), tail.end(), [&visited](int*) { ++visited; });
+    assert(visited == 10);
+    // Указатели на void предвыбираются одной линией, указатели на функции —
+    // по своему адресу
+    SimpleVector<void*> untyped;
+    for (int& value : values) {
+        untyped.PushBack(&value);
+    }
+    long long untyped_sum = 0;
+    ForEachPrefetched(untyped, [&untyped_sum](void* value) {
+        untyped_sum += *static_cast<int*>(value);
+    });
+    assert(untyped_sum == 999 * 1000 / 2);
+    using Callback = int (*)(int);
+    SimpleVector<Callback> callbacks(3, [](int value) { return value + 1; });
+    int chained = 0;
+    ForEachPrefetched(callbacks, [&chained](Callback callback) { chained = callback(chained); });
+    assert(chained == 3);
+    // Функциональный объект возвращается, как у std::for_each
+    auto counter = ForEachPrefetched(values, [count = 0](const int&) mutable { return ++count; });
+    assert(counter(0) == 1001);
+
+    // Выборка по индексам
+    SimpleVector<size_t> indices;
+    for (size_t i = 0; i < 500; ++i) {
+        indices.PushBack(i * 7919 % 1000);
+    }
+    SimpleVector<int> gathered(indices.GetSize());
+    int* gathered_end = Gather(values, indices, gathered.begin());
+    assert(gathered_end == gathered.end());
+    for (size_t i = 0; i < indices.GetSize(); ++i) {
+        assert(gathered[i] == static_cast<int>(indices[i]));
+    }
+    vector<int> short_gather;
+    Gather(values, indices.begin(), indices.begin() + 3, back_inserter(short_gather), 100);
+    assert((short_gather == vector<int>{0, 7919 % 1000, 2 * 7919 % 1000}));
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAdoptRelease() {
+    cout << "Test Adopt and Release"s << endl;
+    // Буфер, выделенный аллокатором вектора, передаётся без копирования
+    allocator<int> alloc;
+    int* data = alloc.allocate(8);
+    for (int i = 0; i < 5; ++i) {
+        data[i] = i * 10;
+    }
+    SimpleVector<int> adopted = SimpleVector<int>::Adopt(data, 5, 8);
+    assert(adopted.Data() == data && adopted.GetSize() == 5 && adopted.GetCapacity() == 8);
+    adopted.PushBack(50);
+    assert(adopted.Data() == data && adopted[5] == 50);
+
+    SimpleVectorBuffer<int> buffer = adopted.Release();
+    assert(buffer.data == data && buffer.size == 6 && buffer.capacity == 8);
+    assert(adopted.IsEmpty() && adopted.GetCapacity() == 0 && adopted.Data() == nullptr);
+    adopted.PushBack(1);
+    SimpleVector<int> readopted = SimpleVector<int>::Adopt(buffer);
+    assert(readopted.Data() == data && readopted[5] == 50);
+
+    SimpleVector<int> empty = SimpleVector<int>::Adopt(nullptr, 0, 0);
+    assert(empty.IsEmpty() && empty.GetCapacity() == 0);
+
+    // Элементы с нетривиальным временем жизни остаются созданными
+    SimpleVector<string> strings = {"a"s, "bb"s};
+    SimpleVectorBuffer<string> released = strings.Release();
+    SimpleVector<string> restored = SimpleVector<string>::Adopt(released);
+    assert((restored == SimpleVector<string>{"a"s, "bb"s}));
+
+    // Обмен с std::vector
+    vector<int> ints = {1, 2, 3};
+    SimpleVector<int> from_std = FromStdVector(std::move(ints));
+    assert((from_std == SimpleVector<int>{1, 2, 3}) && ints.empty());
+    vector<int> to_std = ToStdVector(std::move(from_std));
+    assert((to_std == vector<int>{1, 2, 3}) && from_std.IsEmpty());
+
+    vector<X> xs;
+    xs.emplace_back(7);
+    xs.emplace_back(8);
+    auto x_vector = FromStdVector<OneAndHalfGrowth>(std::move(xs));
+    static_assert(is_same_v<decltype(x_vector)::GrowthPolicyType, OneAndHalfGrowth>);
+    assert(x_vector.GetSize() == 2 && x_vector[1].GetX() == 8 && xs.empty());
+    vector<X> xs_back = ToStdVector(std::move(x_vector));
+    assert(xs_back.size() == 2 && xs_back[0].GetX() == 7);
+
+    std::pmr::monotonic_buffer_resource resource;
+    vector<string> names = {"left"s, "right"s};
+    PmrSimpleVector<string> pmr_names =
+        FromStdVector(std::move(names), std::pmr::polymorphic_allocator<string>(&resource));
+    assert(pmr_names.GetAllocator().resource() == &resource && pmr_names[1] == "right"s);
+    std::pmr::vector<string> pmr_back =
+        ToStdVector(std::move(pmr_names), std::pmr::polymorphic_allocator<string>(&resource));
+    assert(pmr_back.size() == 2 && pmr_back[0] == "left"s);
+    cout << "Done!"s << endl << endl;
+}
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -159,5 +2228,34 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestRawStorage();
+    TestPmrAllocator();
+    TestSmallSimpleVector();
+    TestTriviallyRelocatable();
+    TestGrowthPolicy();
+    TestEmplace();
+    TestRangeInsertion();
+    TestRangeErase();
+    TestShrink();
+    TestStrongExceptionGuarantee();
+    TestStats();
+    TestSimdComparison();
+    TestNumericKernels();
+    TestAlignedStorage();
+    TestParallelConstruction();
+    TestMmapStorage();
+    TestVectorFile();
+    TestSimpleVectorView();
+    TestCowSimpleVector();
+    TestConcurrentSimpleVector();
+    TestThreadLocalAppender();
+    TestParallelAlgorithms();
+    TestSoaSimpleVector();
+    TestSegmentedSimpleVector();
+    TestDequeSimpleVector();
+    TestRingBuffer();
+    TestStaticVector();
+    TestPrefetch();
+    TestAdoptRelease();
     return 0;
 }
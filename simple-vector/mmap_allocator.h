@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include <sys/mman.h>
+
+#include "simple_vector.h"
+
+// Аллокатор для очень больших векторов. Каждый буфер получает собственный
+// диапазон виртуальных адресов размером не меньше reserve_bytes, выделенный
+// mmap без резервирования памяти (MAP_NORESERVE): физические страницы
+// появляются только при первой записи. Диапазон выровнен по 2 МиБ и помечен
+// MADV_HUGEPAGE, поэтому ядро может отображать его большими страницами.
+// Пока новый размер помещается в диапазон, TryExpand увеличивает буфер на
+// месте, и вектор растёт без перевыделения и копирования элементов
+template <typename Type>
+class MmapAllocator {
+public:
+    using value_type = Type;
+    // Размер диапазона зависит от reserve_bytes, поэтому аллокатор следует за
+    // памятью при любых операциях контейнера
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    static constexpr size_t kHugePageSize = size_t{2} << 20;
+    static constexpr size_t kAlignment = kHugePageSize;
+    static constexpr size_t kDefaultReserveBytes = size_t{4} << 30;
+
+    template <typename Other>
+    struct rebind {
+        using other = MmapAllocator<Other>;
+    };
+
+    // reserve_bytes округляется вверх до размера большой страницы
+    explicit MmapAllocator(size_t reserve_bytes = kDefaultReserveBytes) noexcept
+        : reserve_bytes_(RoundUpToHugePage(reserve_bytes)) {
+    }
+
+    template <typename Other>
+    MmapAllocator(const MmapAllocator<Other>& other) noexcept
+        : reserve_bytes_(other.GetReserveBytes()) {
+    }
+
+    // Резервирует диапазон адресов под count элементов.
+    // Выбрасывает исключение std::bad_alloc, если mmap завершился ошибкой
+    [[nodiscard]] Type* allocate(size_t count) {
+        if (count > max_size()) {
+            throw std::bad_array_new_length();
+        }
+
+        const size_t reserved = ReservedBytes(count);
+        // Отображение с запасом в одну большую страницу, чтобы выровнять начало
+        const size_t mapped = reserved + kHugePageSize;
+        void* raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw);
+        const std::uintptr_t aligned =
+            (start + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+        if (aligned != start) {
+            munmap(raw, aligned - start);
+        }
+        const std::uintptr_t tail = aligned + reserved;
+        if (tail != start + mapped) {
+            munmap(reinterpret_cast<void*>(tail), start + mapped - tail);
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(reinterpret_cast<void*>(aligned), reserved, MADV_HUGEPAGE);
+#endif
+
+        return reinterpret_cast<Type*>(aligned);
+    }
+
+    void deallocate(Type* ptr, size_t count) noexcept {
+        munmap(ptr, ReservedBytes(count));
+    }
+
+    // Увеличивает буфер ptr из old_count элементов до new_count элементов на
+    // месте. Возвращает false, если новый размер не помещается в диапазон
+    bool TryExpand(Type* ptr, size_t old_count, size_t new_count) const noexcept {
+        return ptr != nullptr && new_count <= max_size() &&
+               new_count * sizeof(Type) <= ReservedBytes(old_count);
+    }
+
+    size_t max_size() const noexcept {
+        return (std::numeric_limits<size_t>::max() - 2 * kHugePageSize) / sizeof(Type);
+    }
+
+    size_t GetReserveBytes() const noexcept {
+        return reserve_bytes_;
+    }
+
+private:
+    // Размер диапазона для count элементов. Пока буфер растёт внутри диапазона,
+    // результат не меняется, поэтому deallocate получает тот же размер,
+    // что и allocate
+    size_t ReservedBytes(size_t count) const noexcept {
+        const size_t rounded = RoundUpToHugePage(count * sizeof(Type));
+        return rounded > reserve_bytes_ ? rounded : reserve_bytes_;
+    }
+
+    static size_t RoundUpToHugePage(size_t bytes) noexcept {
+        return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    }
+
+    size_t reserve_bytes_;
+};
+
+template <typename Type, typename Other>
+bool operator==(const MmapAllocator<Type>& lhs, const MmapAllocator<Other>& rhs) noexcept {
+    return lhs.GetReserveBytes() == rhs.GetReserveBytes();
+}
+
+template <typename Type, typename Other>
+bool operator!=(const MmapAllocator<Type>& lhs, const MmapAllocator<Other>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// SimpleVector в диапазоне адресов, зарезервированном mmap
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+using MmapSimpleVector = SimpleVector<Type, MmapAllocator<Type>, GrowthPolicy>;
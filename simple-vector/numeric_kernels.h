@@ -0,0 +1,565 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "cpu_features.h"
+#include "simple_vector.h"
+
+// Векторизованные численные ядра над непрерывными массивами.
+// Функции принимают указатель и длину либо SimpleVector. Для float и double
+// используется AVX2 с FMA, если процессор их поддерживает, или NEON на AArch64;
+// для остальных арифметических типов и на прочих процессорах работает
+// скалярная версия с несколькими независимыми аккумуляторами.
+// Порядок сложения отличается от последовательного, поэтому суммы float и
+// double могут отличаться от std::accumulate в пределах ошибки округления.
+// Для Min, Max, ArgMin и ArgMax массив не должен содержать NaN
+namespace numeric {
+
+namespace detail {
+
+template <typename Type>
+inline constexpr bool kHasSimdKernels =
+    std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+// Не даёт выводить Type из скалярного аргумента, чтобы Scale(v, 2) работал
+// для вектора float
+template <typename Type>
+struct NonDeducedHelper {
+    using type = Type;
+};
+
+template <typename Type>
+using NonDeduced = typename NonDeducedHelper<Type>::type;
+
+// Количество независимых аккумуляторов: скрывает задержку сложения
+inline constexpr size_t kAccumulators = 4;
+
+template <typename Type>
+Type SumScalar(const Type* data, size_t size) noexcept {
+    std::array<Type, kAccumulators> acc{};
+    size_t i = 0;
+    for (; i + kAccumulators <= size; i += kAccumulators) {
+        for (size_t j = 0; j < kAccumulators; ++j) {
+            acc[j] += data[i + j];
+        }
+    }
+    for (; i < size; ++i) {
+        acc[0] += data[i];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+template <typename Type>
+Type DotScalar(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    std::array<Type, kAccumulators> acc{};
+    size_t i = 0;
+    for (; i + kAccumulators <= size; i += kAccumulators) {
+        for (size_t j = 0; j < kAccumulators; ++j) {
+            acc[j] += lhs[i + j] * rhs[i + j];
+        }
+    }
+    for (; i < size; ++i) {
+        acc[0] += lhs[i] * rhs[i];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+template <typename Type>
+void AxpyScalar(Type alpha, const Type* x, Type* y, size_t size) noexcept {
+    for (size_t i = 0; i < size; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+template <typename Type>
+void ScaleScalar(Type* data, size_t size, Type factor) noexcept {
+    for (size_t i = 0; i < size; ++i) {
+        data[i] *= factor;
+    }
+}
+
+// Массивы для MinScalar и MaxScalar не пусты
+template <typename Type>
+Type MinScalar(const Type* data, size_t size) noexcept {
+    return *std::min_element(data, data + size);
+}
+
+template <typename Type>
+Type MaxScalar(const Type* data, size_t size) noexcept {
+    return *std::max_element(data, data + size);
+}
+
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+
+// Операции над регистрами AVX2 для float и double
+template <typename Type>
+struct Avx2Ops;
+
+template <>
+struct Avx2Ops<float> {
+    using Register = __m256;
+    static constexpr size_t kWidth = 8;
+
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Zero() noexcept {
+        return _mm256_setzero_ps();
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Broadcast(float value) noexcept {
+        return _mm256_set1_ps(value);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Load(const float* data) noexcept {
+        return _mm256_loadu_ps(data);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static void Store(float* data, Register value) noexcept {
+        _mm256_storeu_ps(data, value);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Add(Register lhs, Register rhs) noexcept {
+        return _mm256_add_ps(lhs, rhs);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Mul(Register lhs, Register rhs) noexcept {
+        return _mm256_mul_ps(lhs, rhs);
+    }
+    // Возвращает lhs * rhs + acc
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register MulAdd(Register lhs, Register rhs,
+                                                         Register acc) noexcept {
+        return _mm256_fmadd_ps(lhs, rhs, acc);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Min(Register lhs, Register rhs) noexcept {
+        return _mm256_min_ps(lhs, rhs);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Max(Register lhs, Register rhs) noexcept {
+        return _mm256_max_ps(lhs, rhs);
+    }
+};
+
+template <>
+struct Avx2Ops<double> {
+    using Register = __m256d;
+    static constexpr size_t kWidth = 4;
+
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Zero() noexcept {
+        return _mm256_setzero_pd();
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Broadcast(double value) noexcept {
+        return _mm256_set1_pd(value);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Load(const double* data) noexcept {
+        return _mm256_loadu_pd(data);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static void Store(double* data, Register value) noexcept {
+        _mm256_storeu_pd(data, value);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Add(Register lhs, Register rhs) noexcept {
+        return _mm256_add_pd(lhs, rhs);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Mul(Register lhs, Register rhs) noexcept {
+        return _mm256_mul_pd(lhs, rhs);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register MulAdd(Register lhs, Register rhs,
+                                                         Register acc) noexcept {
+        return _mm256_fmadd_pd(lhs, rhs, acc);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Min(Register lhs, Register rhs) noexcept {
+        return _mm256_min_pd(lhs, rhs);
+    }
+    SIMPLE_VECTOR_TARGET_AVX2_FMA static Register Max(Register lhs, Register rhs) noexcept {
+        return _mm256_max_pd(lhs, rhs);
+    }
+};
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2_FMA Type SumAvx2(const Type* data, size_t size) noexcept {
+    using Ops = Avx2Ops<Type>;
+    constexpr size_t kStep = Ops::kWidth * kAccumulators;
+    typename Ops::Register acc[kAccumulators] = {Ops::Zero(), Ops::Zero(), Ops::Zero(),
+                                                 Ops::Zero()};
+    size_t i = 0;
+    for (; i + kStep <= size; i += kStep) {
+        for (size_t j = 0; j < kAccumulators; ++j) {
+            acc[j] = Ops::Add(acc[j], Ops::Load(data + i + j * Ops::kWidth));
+        }
+    }
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        acc[0] = Ops::Add(acc[0], Ops::Load(data + i));
+    }
+    alignas(32) Type lanes[Ops::kWidth];
+    Ops::Store(lanes, Ops::Add(Ops::Add(acc[0], acc[1]), Ops::Add(acc[2], acc[3])));
+    return SumScalar(lanes, Ops::kWidth) + SumScalar(data + i, size - i);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2_FMA Type DotAvx2(const Type* lhs, const Type* rhs,
+                                           size_t size) noexcept {
+    using Ops = Avx2Ops<Type>;
+    constexpr size_t kStep = Ops::kWidth * kAccumulators;
+    typename Ops::Register acc[kAccumulators] = {Ops::Zero(), Ops::Zero(), Ops::Zero(),
+                                                 Ops::Zero()};
+    size_t i = 0;
+    for (; i + kStep <= size; i += kStep) {
+        for (size_t j = 0; j < kAccumulators; ++j) {
+            const size_t offset = i + j * Ops::kWidth;
+            acc[j] = Ops::MulAdd(Ops::Load(lhs + offset), Ops::Load(rhs + offset), acc[j]);
+        }
+    }
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        acc[0] = Ops::MulAdd(Ops::Load(lhs + i), Ops::Load(rhs + i), acc[0]);
+    }
+    alignas(32) Type lanes[Ops::kWidth];
+    Ops::Store(lanes, Ops::Add(Ops::Add(acc[0], acc[1]), Ops::Add(acc[2], acc[3])));
+    return SumScalar(lanes, Ops::kWidth) + DotScalar(lhs + i, rhs + i, size - i);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2_FMA void AxpyAvx2(Type alpha, const Type* x, Type* y,
+                                            size_t size) noexcept {
+    using Ops = Avx2Ops<Type>;
+    const typename Ops::Register factor = Ops::Broadcast(alpha);
+    size_t i = 0;
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        Ops::Store(y + i, Ops::MulAdd(factor, Ops::Load(x + i), Ops::Load(y + i)));
+    }
+    AxpyScalar(alpha, x + i, y + i, size - i);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2_FMA void ScaleAvx2(Type* data, size_t size,
+                                             Type factor) noexcept {
+    using Ops = Avx2Ops<Type>;
+    const typename Ops::Register multiplier = Ops::Broadcast(factor);
+    size_t i = 0;
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        Ops::Store(data + i, Ops::Mul(Ops::Load(data + i), multiplier));
+    }
+    ScaleScalar(data + i, size - i, factor);
+}
+
+// Возвращает минимум (IsMin) или максимум непустого массива
+template <bool IsMin, typename Type>
+SIMPLE_VECTOR_TARGET_AVX2_FMA Type ExtremumAvx2(const Type* data, size_t size) noexcept {
+    using Ops = Avx2Ops<Type>;
+    if (size < Ops::kWidth) {
+        return IsMin ? MinScalar(data, size) : MaxScalar(data, size);
+    }
+    typename Ops::Register acc = Ops::Load(data);
+    size_t i = Ops::kWidth;
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        const typename Ops::Register next = Ops::Load(data + i);
+        acc = IsMin ? Ops::Min(acc, next) : Ops::Max(acc, next);
+    }
+    // Хвост обрабатывается последним полным регистром, перекрывающим уже
+    // просмотренные элементы
+    const typename Ops::Register last = Ops::Load(data + size - Ops::kWidth);
+    acc = IsMin ? Ops::Min(acc, last) : Ops::Max(acc, last);
+    alignas(32) Type lanes[Ops::kWidth];
+    Ops::Store(lanes, acc);
+    return IsMin ? MinScalar(lanes, Ops::kWidth) : MaxScalar(lanes, Ops::kWidth);
+}
+
+#endif
+
+#if defined(SIMPLE_VECTOR_HAS_NEON)
+
+// Операции над регистрами NEON для float и double
+template <typename Type>
+struct NeonOps;
+
+template <>
+struct NeonOps<float> {
+    using Register = float32x4_t;
+    static constexpr size_t kWidth = 4;
+
+    static Register Zero() noexcept { return vdupq_n_f32(0.0f); }
+    static Register Broadcast(float value) noexcept { return vdupq_n_f32(value); }
+    static Register Load(const float* data) noexcept { return vld1q_f32(data); }
+    static void Store(float* data, Register value) noexcept { vst1q_f32(data, value); }
+    static Register Add(Register lhs, Register rhs) noexcept { return vaddq_f32(lhs, rhs); }
+    static Register Mul(Register lhs, Register rhs) noexcept { return vmulq_f32(lhs, rhs); }
+    static Register MulAdd(Register lhs, Register rhs, Register acc) noexcept {
+        return vfmaq_f32(acc, lhs, rhs);
+    }
+    static Register Min(Register lhs, Register rhs) noexcept { return vminq_f32(lhs, rhs); }
+    static Register Max(Register lhs, Register rhs) noexcept { return vmaxq_f32(lhs, rhs); }
+};
+
+template <>
+struct NeonOps<double> {
+    using Register = float64x2_t;
+    static constexpr size_t kWidth = 2;
+
+    static Register Zero() noexcept { return vdupq_n_f64(0.0); }
+    static Register Broadcast(double value) noexcept { return vdupq_n_f64(value); }
+    static Register Load(const double* data) noexcept { return vld1q_f64(data); }
+    static void Store(double* data, Register value) noexcept { vst1q_f64(data, value); }
+    static Register Add(Register lhs, Register rhs) noexcept { return vaddq_f64(lhs, rhs); }
+    static Register Mul(Register lhs, Register rhs) noexcept { return vmulq_f64(lhs, rhs); }
+    static Register MulAdd(Register lhs, Register rhs, Register acc) noexcept {
+        return vfmaq_f64(acc, lhs, rhs);
+    }
+    static Register Min(Register lhs, Register rhs) noexcept { return vminq_f64(lhs, rhs); }
+    static Register Max(Register lhs, Register rhs) noexcept { return vmaxq_f64(lhs, rhs); }
+};
+
+template <typename Type>
+Type SumNeon(const Type* data, size_t size) noexcept {
+    using Ops = NeonOps<Type>;
+    constexpr size_t kStep = Ops::kWidth * kAccumulators;
+    typename Ops::Register acc[kAccumulators] = {Ops::Zero(), Ops::Zero(), Ops::Zero(),
+                                                 Ops::Zero()};
+    size_t i = 0;
+    for (; i + kStep <= size; i += kStep) {
+        for (size_t j = 0; j < kAccumulators; ++j) {
+            acc[j] = Ops::Add(acc[j], Ops::Load(data + i + j * Ops::kWidth));
+        }
+    }
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        acc[0] = Ops::Add(acc[0], Ops::Load(data + i));
+    }
+    Type lanes[Ops::kWidth];
+    Ops::Store(lanes, Ops::Add(Ops::Add(acc[0], acc[1]), Ops::Add(acc[2], acc[3])));
+    return SumScalar(lanes, Ops::kWidth) + SumScalar(data + i, size - i);
+}
+
+template <typename Type>
+Type DotNeon(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    using Ops = NeonOps<Type>;
+    constexpr size_t kStep = Ops::kWidth * kAccumulators;
+    typename Ops::Register acc[kAccumulators] = {Ops::Zero(), Ops::Zero(), Ops::Zero(),
+                                                 Ops::Zero()};
+    size_t i = 0;
+    for (; i + kStep <= size; i += kStep) {
+        for (size_t j = 0; j < kAccumulators; ++j) {
+            const size_t offset = i + j * Ops::kWidth;
+            acc[j] = Ops::MulAdd(Ops::Load(lhs + offset), Ops::Load(rhs + offset), acc[j]);
+        }
+    }
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        acc[0] = Ops::MulAdd(Ops::Load(lhs + i), Ops::Load(rhs + i), acc[0]);
+    }
+    Type lanes[Ops::kWidth];
+    Ops::Store(lanes, Ops::Add(Ops::Add(acc[0], acc[1]), Ops::Add(acc[2], acc[3])));
+    return SumScalar(lanes, Ops::kWidth) + DotScalar(lhs + i, rhs + i, size - i);
+}
+
+template <typename Type>
+void AxpyNeon(Type alpha, const Type* x, Type* y, size_t size) noexcept {
+    using Ops = NeonOps<Type>;
+    const typename Ops::Register factor = Ops::Broadcast(alpha);
+    size_t i = 0;
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        Ops::Store(y + i, Ops::MulAdd(factor, Ops::Load(x + i), Ops::Load(y + i)));
+    }
+    AxpyScalar(alpha, x + i, y + i, size - i);
+}
+
+template <typename Type>
+void ScaleNeon(Type* data, size_t size, Type factor) noexcept {
+    using Ops = NeonOps<Type>;
+    const typename Ops::Register multiplier = Ops::Broadcast(factor);
+    size_t i = 0;
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        Ops::Store(data + i, Ops::Mul(Ops::Load(data + i), multiplier));
+    }
+    ScaleScalar(data + i, size - i, factor);
+}
+
+template <bool IsMin, typename Type>
+Type ExtremumNeon(const Type* data, size_t size) noexcept {
+    using Ops = NeonOps<Type>;
+    if (size < Ops::kWidth) {
+        return IsMin ? MinScalar(data, size) : MaxScalar(data, size);
+    }
+    typename Ops::Register acc = Ops::Load(data);
+    size_t i = Ops::kWidth;
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        const typename Ops::Register next = Ops::Load(data + i);
+        acc = IsMin ? Ops::Min(acc, next) : Ops::Max(acc, next);
+    }
+    const typename Ops::Register last = Ops::Load(data + size - Ops::kWidth);
+    acc = IsMin ? Ops::Min(acc, last) : Ops::Max(acc, last);
+    Type lanes[Ops::kWidth];
+    Ops::Store(lanes, acc);
+    return IsMin ? MinScalar(lanes, Ops::kWidth) : MaxScalar(lanes, Ops::kWidth);
+}
+
+#endif
+
+template <bool IsMin, typename Type>
+Type Extremum(const Type* data, size_t size) {
+    if (size == 0) {
+        throw std::out_of_range("Empty range has no extremum");
+    }
+    if constexpr (kHasSimdKernels<Type>) {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+        if (::detail::CpuHasAvx2Fma()) {
+            return ExtremumAvx2<IsMin>(data, size);
+        }
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+        return ExtremumNeon<IsMin>(data, size);
+#endif
+    }
+    return IsMin ? MinScalar(data, size) : MaxScalar(data, size);
+}
+
+}  // namespace detail
+
+// Возвращает сумму size элементов
+template <typename Type>
+Type Sum(const Type* data, size_t size) noexcept {
+    static_assert(std::is_arithmetic_v<Type>);
+    if constexpr (detail::kHasSimdKernels<Type>) {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+        if (::detail::CpuHasAvx2Fma()) {
+            return detail::SumAvx2(data, size);
+        }
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+        return detail::SumNeon(data, size);
+#endif
+    }
+    return detail::SumScalar(data, size);
+}
+
+// Возвращает скалярное произведение массивов длины size
+template <typename Type>
+Type Dot(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    static_assert(std::is_arithmetic_v<Type>);
+    if constexpr (detail::kHasSimdKernels<Type>) {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+        if (::detail::CpuHasAvx2Fma()) {
+            return detail::DotAvx2(lhs, rhs, size);
+        }
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+        return detail::DotNeon(lhs, rhs, size);
+#endif
+    }
+    return detail::DotScalar(lhs, rhs, size);
+}
+
+// Вычисляет y[i] += alpha * x[i]. Массивы не должны частично перекрываться
+template <typename Type>
+void Axpy(detail::NonDeduced<Type> alpha, const Type* x, Type* y,
+          size_t size) noexcept {
+    static_assert(std::is_arithmetic_v<Type>);
+    if constexpr (detail::kHasSimdKernels<Type>) {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+        if (::detail::CpuHasAvx2Fma()) {
+            detail::AxpyAvx2(alpha, x, y, size);
+            return;
+        }
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+        detail::AxpyNeon(alpha, x, y, size);
+        return;
+#endif
+    }
+    detail::AxpyScalar(alpha, x, y, size);
+}
+
+// Умножает каждый элемент на factor
+template <typename Type>
+void Scale(Type* data, size_t size, detail::NonDeduced<Type> factor) noexcept {
+    static_assert(std::is_arithmetic_v<Type>);
+    if constexpr (detail::kHasSimdKernels<Type>) {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+        if (::detail::CpuHasAvx2Fma()) {
+            detail::ScaleAvx2(data, size, factor);
+            return;
+        }
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+        detail::ScaleNeon(data, size, factor);
+        return;
+#endif
+    }
+    detail::ScaleScalar(data, size, factor);
+}
+
+// Возвращает наименьший элемент
+// Выбрасывает исключение std::out_of_range, если массив пуст
+template <typename Type>
+Type Min(const Type* data, size_t size) {
+    static_assert(std::is_arithmetic_v<Type>);
+    return detail::Extremum<true>(data, size);
+}
+
+// Возвращает наибольший элемент
+// Выбрасывает исключение std::out_of_range, если массив пуст
+template <typename Type>
+Type Max(const Type* data, size_t size) {
+    static_assert(std::is_arithmetic_v<Type>);
+    return detail::Extremum<false>(data, size);
+}
+
+// Возвращает индекс первого наименьшего элемента или size для пустого массива.
+// Минимум находится векторным проходом, индекс — вторым проходом до первого
+// совпадения
+template <typename Type>
+size_t ArgMin(const Type* data, size_t size) {
+    if (size == 0) {
+        return size;
+    }
+    return std::find(data, data + size, Min(data, size)) - data;
+}
+
+// Возвращает индекс первого наибольшего элемента или size для пустого массива
+template <typename Type>
+size_t ArgMax(const Type* data, size_t size) {
+    if (size == 0) {
+        return size;
+    }
+    return std::find(data, data + size, Max(data, size)) - data;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+Type Sum(const SimpleVector<Type, Allocator, GrowthPolicy>& vector) noexcept {
+    return Sum(vector.begin(), vector.GetSize());
+}
+
+// Выбрасывает исключение std::invalid_argument, если размеры векторов различны
+template <typename Type, typename Allocator, typename GrowthPolicy>
+Type Dot(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+         const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        throw std::invalid_argument("Vectors must have the same size");
+    }
+    return Dot(lhs.begin(), rhs.begin(), lhs.GetSize());
+}
+
+// Выбрасывает исключение std::invalid_argument, если размеры векторов различны
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void Axpy(detail::NonDeduced<Type> alpha,
+          const SimpleVector<Type, Allocator, GrowthPolicy>& x,
+          SimpleVector<Type, Allocator, GrowthPolicy>& y) {
+    if (x.GetSize() != y.GetSize()) {
+        throw std::invalid_argument("Vectors must have the same size");
+    }
+    Axpy(alpha, x.begin(), y.begin(), x.GetSize());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void Scale(SimpleVector<Type, Allocator, GrowthPolicy>& vector,
+           detail::NonDeduced<Type> factor) noexcept {
+    Scale(vector.begin(), vector.GetSize(), factor);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+Type Min(const SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    return Min(vector.begin(), vector.GetSize());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+Type Max(const SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    return Max(vector.begin(), vector.GetSize());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+size_t ArgMin(const SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    return ArgMin(vector.begin(), vector.GetSize());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+size_t ArgMax(const SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    return ArgMax(vector.begin(), vector.GetSize());
+}
+
+}  // namespace numeric
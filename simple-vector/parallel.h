@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "trivially_relocatable.h"
+#include "uninitialized_memory.h"
+
+// Параметры параллельного заполнения и копирования больших буферов.
+// Буфер делится на куски, границы которых выровнены по страницам памяти,
+// и каждый кусок создаётся своим потоком. Страница впервые записывается тем
+// потоком, который создаёт кусок, поэтому на системах NUMA она выделяется на
+// узле, где этот поток выполнялся при записи. Потоки к узлам не привязаны:
+// ParallelFor с той же политикой делит буфер на те же куски, но запускает
+// новые потоки, и планировщик может разместить их на любых узлах
+struct ParallelPolicy {
+    // Наименьший объём работы в байтах, ради которого запускается поток.
+    // Буферы меньше двух таких кусков обрабатываются в вызывающем потоке
+    size_t min_chunk_bytes = size_t{1} << 20;
+    // Наибольшее число потоков. 0 означает std::thread::hardware_concurrency()
+    size_t max_threads = 0;
+};
+
+namespace detail {
+
+inline constexpr size_t kPageSize = 4096;
+
+// Делит count элементов размером element_size, начинающихся по адресу base,
+// на куски. Возвращает их границы: кусок i занимает [bounds[i], bounds[i + 1]).
+// Внутренние границы сдвинуты так, чтобы кусок начинался с новой страницы
+inline std::vector<size_t> ChunkBounds(const ParallelPolicy& policy, const void* base,
+                                       size_t count, size_t element_size) {
+    const size_t threads = policy.max_threads != 0
+                               ? policy.max_threads
+                               : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t bytes = count * element_size;
+    const size_t chunks = std::clamp<size_t>(
+        bytes / std::max<size_t>(policy.min_chunk_bytes, 1), 1, threads);
+
+    std::vector<size_t> bounds;
+    bounds.reserve(chunks + 1);
+    bounds.push_back(0);
+    const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(base);
+    for (size_t i = 1; i < chunks; ++i) {
+        const std::uintptr_t target = start + bytes / chunks * i;
+        const std::uintptr_t page = (target + kPageSize - 1) / kPageSize * kPageSize;
+        const size_t index = (page - start + element_size - 1) / element_size;
+        if (index > bounds.back() && index < count) {
+            bounds.push_back(index);
+        }
+    }
+    bounds.push_back(count);
+
+    return bounds;
+}
+
+// Вызывает fn(first, last) для каждого куска: первый кусок обрабатывает
+// вызывающий поток, остальные — новые потоки. Если поток создать не удалось,
+// оставшиеся куски обрабатываются в вызывающем потоке.
+// Возвращает исключения, выброшенные при обработке кусков
+template <typename Fn>
+std::vector<std::exception_ptr> RunChunks(const std::vector<size_t>& bounds, Fn& fn) {
+    const size_t chunks = bounds.size() - 1;
+    std::vector<std::exception_ptr> errors(chunks);
+    auto run = [&bounds, &errors, &fn](size_t chunk) noexcept {
+        try {
+            fn(bounds[chunk], bounds[chunk + 1]);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    try {
+        workers.reserve(chunks - 1);
+        for (size_t chunk = 1; chunk < chunks; ++chunk) {
+            workers.emplace_back(run, chunk);
+        }
+    } catch (...) {
+        for (size_t chunk = workers.size() + 1; chunk < chunks; ++chunk) {
+            run(chunk);
+        }
+    }
+    run(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    return errors;
+}
+
+// Создаёт count элементов в неинициализированной памяти dest, вызывая
+// construct(first, last) для кусков [first, last) параллельно. construct
+// создаёт элементы dest[first, last) и при исключении сам разрушает созданные
+// им элементы. Если хотя бы один кусок не удалось создать, остальные куски
+// разрушаются и выбрасывается первое исключение.
+// Аллокатор должен допускать одновременные вызовы construct из разных потоков
+template <typename Allocator, typename Type, typename ConstructChunk>
+void ParallelConstruct(const ParallelPolicy& policy, Allocator& alloc, Type* dest,
+                       size_t count, ConstructChunk construct) {
+    const std::vector<size_t> bounds = ChunkBounds(policy, dest, count, sizeof(Type));
+    if (bounds.size() == 2) {
+        construct(size_t{0}, count);
+        return;
+    }
+
+    const std::vector<std::exception_ptr> errors = RunChunks(bounds, construct);
+    const auto failed = std::find_if(errors.begin(), errors.end(),
+                                     [](const std::exception_ptr& error) {
+                                         return error != nullptr;
+                                     });
+    if (failed == errors.end()) {
+        return;
+    }
+    for (size_t chunk = 0; chunk < errors.size(); ++chunk) {
+        if (errors[chunk] == nullptr) {
+            Destroy(alloc, dest + bounds[chunk], dest + bounds[chunk + 1]);
+        }
+    }
+    std::rethrow_exception(*failed);
+}
+
+// Параллельный аналог Relocate: переносит элементы [first, last) в dest
+template <typename Allocator, typename Type>
+void ParallelRelocate(const ParallelPolicy& policy, Allocator& alloc, Type* first,
+                      Type* last, Type* dest) {
+    ParallelConstruct(policy, alloc, dest, last - first,
+                      [&alloc, first, dest](size_t begin, size_t end) {
+                          if constexpr (kIsTriviallyRelocatable<Type>) {
+                              CopyBytes(dest + begin, first + begin, end - begin);
+                          } else {
+                              UninitializedMoveIfNoexcept(alloc, first + begin,
+                                                          first + end, dest + begin);
+                          }
+                      });
+    if constexpr (!kIsTriviallyRelocatable<Type>) {
+        Destroy(alloc, first, last);
+    }
+}
+
+}  // namespace detail
+
+// Вызывает fn(chunk_first, chunk_last) для кусков диапазона [first, last),
+// разделённого так же, как при параллельном создании вектора с политикой
+// policy. Куски обрабатываются параллельно, fn должна быть потокобезопасной.
+// После завершения всех кусков выбрасывает первое возникшее исключение
+template <typename Type, typename Fn>
+void ParallelFor(const ParallelPolicy& policy, Type* first, Type* last, Fn fn) {
+    const std::vector<size_t> bounds =
+        detail::ChunkBounds(policy, first, last - first, sizeof(Type));
+    auto chunk_fn = [first, &fn](size_t begin, size_t end) {
+        fn(first + begin, first + end);
+    };
+    for (const std::exception_ptr& error : detail::RunChunks(bounds, chunk_fn)) {
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+}
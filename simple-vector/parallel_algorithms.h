@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "array_ptr.h"
+#include "parallel.h"
+#include "simple_vector.h"
+
+// Параллельные сортировка и удаление повторов для SimpleVector. Вектор
+// делится на куски так же, как при параллельном создании (см. ParallelPolicy),
+// каждый кусок обрабатывается своим потоком. Вспомогательный буфер для
+// тривиально копируемых элементов берётся из свободной вместимости вектора,
+// если её хватает, и выделяется один раз иначе
+
+namespace detail {
+
+// Вызывает fn(0), ..., fn(count - 1) параллельно и выбрасывает первое
+// возникшее исключение после завершения всех вызовов
+template <typename Fn>
+void RunTasks(size_t count, Fn fn) {
+    std::vector<size_t> bounds(count + 1);
+    std::iota(bounds.begin(), bounds.end(), size_t{0});
+    auto task = [&fn](size_t index, size_t) {
+        fn(index);
+    };
+    for (const std::exception_ptr& error : RunChunks(bounds, task)) {
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+template <typename Type>
+inline constexpr bool kIsRadixSortable =
+    std::is_integral_v<Type> && !std::is_same_v<Type, bool>;
+
+// Сравнение по умолчанию, при котором целые числа можно сортировать
+// поразрядно
+template <typename Compare, typename Type>
+inline constexpr bool kIsDefaultLess = std::is_same_v<Compare, std::less<>> ||
+                                       std::is_same_v<Compare, std::less<Type>>;
+
+// Вспомогательный буфер под size элементов: свободная вместимость вектора,
+// если её хватает, иначе отдельно выделенная память
+template <typename Type, typename Allocator, typename GrowthPolicy>
+class SortScratch {
+public:
+    explicit SortScratch(SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+        const size_t size = vector.GetSize();
+        if (vector.GetCapacity() - size >= size) {
+            data_ = vector.Data() + size;
+        } else {
+            owned_ = ArrayPtr<Type, Allocator>(size, vector.GetAllocator());
+            data_ = owned_.Get();
+        }
+    }
+
+    Type* Get() const noexcept { return data_; }
+
+private:
+    ArrayPtr<Type, Allocator> owned_;
+    Type* data_ = nullptr;
+};
+
+// Параллельно копирует count тривиально копируемых элементов из source в dest
+template <typename Type>
+void ParallelCopyBytes(const ParallelPolicy& policy, Type* dest, const Type* source,
+                       size_t count) {
+    const std::vector<size_t> bounds = ChunkBounds(policy, dest, count, sizeof(Type));
+    RunTasks(bounds.size() - 1, [&](size_t chunk) {
+        CopyBytes(dest + bounds[chunk], source + bounds[chunk],
+                  bounds[chunk + 1] - bounds[chunk]);
+    });
+}
+
+// Сортирует куски параллельно и сливает соседние пары кусков, пока не
+// останется один. С буфером scratch слияние переносит элементы между данными
+// и буфером, без него выполняется std::inplace_merge
+template <typename Type, typename Compare>
+void ParallelMergeSort(const ParallelPolicy& policy, Type* data, size_t size,
+                       Type* scratch, Compare& comp, bool stable) {
+    std::vector<size_t> bounds = ChunkBounds(policy, data, size, sizeof(Type));
+    RunTasks(bounds.size() - 1, [&](size_t chunk) {
+        Type* first = data + bounds[chunk];
+        Type* last = data + bounds[chunk + 1];
+        if (stable) {
+            std::stable_sort(first, last, comp);
+        } else {
+            std::sort(first, last, comp);
+        }
+    });
+
+    Type* from = data;
+    Type* to = scratch;
+    while (bounds.size() > 2) {
+        const size_t runs = bounds.size() - 1;
+        RunTasks((runs + 1) / 2, [&](size_t pair) {
+            const size_t first = bounds[2 * pair];
+            const size_t mid = bounds[std::min(2 * pair + 1, runs)];
+            const size_t last = bounds[std::min(2 * pair + 2, runs)];
+            if (scratch == nullptr) {
+                std::inplace_merge(data + first, data + mid, data + last, comp);
+            } else {
+                std::merge(from + first, from + mid, from + mid, from + last, to + first,
+                           comp);
+            }
+        });
+
+        std::vector<size_t> merged;
+        merged.reserve(runs / 2 + 2);
+        for (size_t i = 0; i < runs; i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        merged.push_back(size);
+        bounds = std::move(merged);
+        if (scratch != nullptr) {
+            std::swap(from, to);
+        }
+    }
+
+    if (from != data) {
+        ParallelCopyBytes(policy, data, from, size);
+    }
+}
+
+template <typename Type>
+using RadixKey = std::make_unsigned_t<Type>;
+
+// Ключ, порядок которого как беззнакового числа совпадает с порядком value
+template <typename Type>
+RadixKey<Type> ToRadixKey(Type value) noexcept {
+    RadixKey<Type> key = static_cast<RadixKey<Type>>(value);
+    if constexpr (std::is_signed_v<Type>) {
+        key ^= RadixKey<Type>{1} << (std::numeric_limits<RadixKey<Type>>::digits - 1);
+    }
+    return key;
+}
+
+// Поразрядная сортировка младшими разрядами вперёд по одному байту за
+// проход. Каждый кусок считает гистограмму и раскладывает свои элементы
+// параллельно. Проход, в котором все элементы попадают в одну корзину,
+// пропускается
+template <typename Type>
+void ParallelRadixSort(const ParallelPolicy& policy, Type* data, size_t size,
+                       Type* scratch) {
+    constexpr size_t kBuckets = 256;
+    const std::vector<size_t> bounds = ChunkBounds(policy, data, size, sizeof(Type));
+    const size_t chunks = bounds.size() - 1;
+    std::vector<std::array<size_t, kBuckets>> offsets(chunks);
+
+    Type* from = data;
+    Type* to = scratch;
+    for (size_t shift = 0; shift < sizeof(Type) * 8; shift += 8) {
+        auto digit = [shift](Type value) {
+            return static_cast<size_t>((ToRadixKey(value) >> shift) & (kBuckets - 1));
+        };
+        RunTasks(chunks, [&](size_t chunk) {
+            std::array<size_t, kBuckets>& counts = offsets[chunk];
+            counts.fill(0);
+            for (size_t i = bounds[chunk]; i != bounds[chunk + 1]; ++i) {
+                ++counts[digit(from[i])];
+            }
+        });
+
+        size_t position = 0;
+        bool single_bucket = false;
+        for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+            const size_t bucket_start = position;
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                const size_t count = offsets[chunk][bucket];
+                offsets[chunk][bucket] = position;
+                position += count;
+            }
+            single_bucket = single_bucket || position - bucket_start == size;
+        }
+        if (single_bucket) {
+            continue;
+        }
+
+        RunTasks(chunks, [&](size_t chunk) {
+            std::array<size_t, kBuckets>& next = offsets[chunk];
+            for (size_t i = bounds[chunk]; i != bounds[chunk + 1]; ++i) {
+                to[next[digit(from[i])]++] = from[i];
+            }
+        });
+        std::swap(from, to);
+    }
+
+    if (from != data) {
+        ParallelCopyBytes(policy, data, from, size);
+    }
+}
+
+// Сортировки короче этого размера выполняются std::sort без разбиения
+inline constexpr size_t kMinParallelSortSize = 256;
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Compare>
+void SortSimpleVector(const ParallelPolicy& policy,
+                      SimpleVector<Type, Allocator, GrowthPolicy>& vector, Compare& comp,
+                      bool stable) {
+    const size_t size = vector.GetSize();
+    if (size < kMinParallelSortSize) {
+        if (stable) {
+            std::stable_sort(vector.begin(), vector.end(), comp);
+        } else {
+            std::sort(vector.begin(), vector.end(), comp);
+        }
+        return;
+    }
+
+    if constexpr (kIsRadixSortable<Type> && kIsDefaultLess<Compare, Type>) {
+        SortScratch scratch(vector);
+        ParallelRadixSort(policy, vector.Data(), size, scratch.Get());
+    } else if constexpr (std::is_trivially_copyable_v<Type>) {
+        SortScratch scratch(vector);
+        ParallelMergeSort(policy, vector.Data(), size, scratch.Get(), comp, stable);
+    } else {
+        ParallelMergeSort(policy, vector.Data(), size, static_cast<Type*>(nullptr), comp,
+                          stable);
+    }
+}
+
+}  // namespace detail
+
+// Сортирует вектор по comp параллельно. Целые числа со сравнением по
+// умолчанию сортируются поразрядно
+template <typename Type, typename Allocator, typename GrowthPolicy,
+          typename Compare = std::less<>>
+void ParallelSort(const ParallelPolicy& policy,
+                  SimpleVector<Type, Allocator, GrowthPolicy>& vector,
+                  Compare comp = Compare()) {
+    detail::SortSimpleVector(policy, vector, comp, false);
+}
+
+// Сортирует вектор по comp параллельно, сохраняя порядок равных элементов
+template <typename Type, typename Allocator, typename GrowthPolicy,
+          typename Compare = std::less<>>
+void ParallelStableSort(const ParallelPolicy& policy,
+                        SimpleVector<Type, Allocator, GrowthPolicy>& vector,
+                        Compare comp = Compare()) {
+    detail::SortSimpleVector(policy, vector, comp, true);
+}
+
+// Поразрядно сортирует вектор целых чисел по возрастанию
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void RadixSort(const ParallelPolicy& policy,
+               SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    static_assert(detail::kIsRadixSortable<Type>, "RadixSort requires integral elements");
+    if (vector.GetSize() > 1) {
+        detail::SortScratch scratch(vector);
+        detail::ParallelRadixSort(policy, vector.Data(), vector.GetSize(), scratch.Get());
+    }
+}
+
+// Оставляет первый элемент из каждой группы подряд идущих эквивалентных по
+// pred элементов, как std::unique, и уменьшает вектор одним вызовом Resize.
+// pred должен быть отношением эквивалентности. Куски обрабатываются
+// параллельно, затем сдвигаются к началу. Возвращает новый размер
+template <typename Type, typename Allocator, typename GrowthPolicy,
+          typename BinaryPredicate = std::equal_to<>>
+size_t ParallelUnique(const ParallelPolicy& policy,
+                      SimpleVector<Type, Allocator, GrowthPolicy>& vector,
+                      BinaryPredicate pred = BinaryPredicate()) {
+    Type* data = vector.Data();
+    const size_t size = vector.GetSize();
+    const std::vector<size_t> bounds = detail::ChunkBounds(policy, data, size, sizeof(Type));
+    const size_t chunks = bounds.size() - 1;
+
+    // Кусок, начинающийся с продолжения группы предыдущего куска, пропускает
+    // эти элементы. Границы ищутся до изменения данных
+    std::vector<size_t> starts(bounds.begin(), bounds.end() - 1);
+    detail::RunTasks(chunks, [&](size_t chunk) {
+        const size_t first = bounds[chunk];
+        if (first != 0) {
+            size_t& start = starts[chunk];
+            while (start != bounds[chunk + 1] && pred(data[first - 1], data[start])) {
+                ++start;
+            }
+        }
+    });
+
+    std::vector<size_t> ends(chunks);
+    detail::RunTasks(chunks, [&](size_t chunk) {
+        ends[chunk] = std::unique(data + starts[chunk], data + bounds[chunk + 1], pred) - data;
+    });
+
+    size_t new_size = ends[0];
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        new_size = std::move(data + starts[chunk], data + ends[chunk], data + new_size) - data;
+    }
+    vector.Resize(new_size);
+
+    return new_size;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Обход последовательностей с программной предвыборкой данных.
+// Последовательный проход по непрерывному массиву аппаратная предвыборка
+// обслуживает сама. Функции ниже нужны, когда каждый шаг обращается по
+// непредсказуемому адресу: при обходе массива указателей и при выборке
+// элементов таблицы по массиву индексов. За distance шагов до обработки
+// элемента процессору сообщается адрес, к которому обратится этот шаг, и
+// промах кэша перекрывается работой над предыдущими элементами.
+// Нулевое distance означает расстояние по умолчанию, зависящее от размера
+// читаемого объекта (см. DefaultPrefetchDistance)
+namespace detail {
+
+inline constexpr size_t kPrefetchLineSize = 64;
+
+// Сколько байт данных держать в пути к кэшу одновременно
+inline constexpr size_t kPrefetchWindowBytes = 16 * kPrefetchLineSize;
+
+inline constexpr size_t kMinPrefetchDistance = 4;
+inline constexpr size_t kMaxPrefetchDistance = 32;
+
+// Предвыборка большого объекта ограничивается несколькими первыми кэш-линиями
+inline constexpr size_t kMaxPrefetchLines = 4;
+
+inline void PrefetchLine(const void* address) noexcept {
+#if defined(__GNUC__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    static_cast<void>(address);
+#endif
+}
+
+// Запрашивает кэш-линии, которые занимает object. Размер объекта по
+// указателю на void неизвестен, и запрашивается одна линия
+template <typename Type>
+void PrefetchObject(const Type* object) noexcept {
+    if constexpr (std::is_void_v<Type>) {
+        PrefetchLine(object);
+    } else {
+        constexpr size_t kLines = std::min(
+            (sizeof(Type) + kPrefetchLineSize - 1) / kPrefetchLineSize, kMaxPrefetchLines);
+        const char* bytes = reinterpret_cast<const char*>(object);
+        for (size_t line = 0; line < kLines; ++line) {
+            PrefetchLine(bytes + line * kPrefetchLineSize);
+        }
+    }
+}
+
+// Указатели на данные предвыбираются по адресу, на который они указывают.
+// Остальные элементы, в том числе указатели на функции, — по своему адресу
+template <typename Element>
+inline constexpr bool kPrefetchPointee =
+    std::is_pointer_v<Element> && !std::is_function_v<std::remove_pointer_t<Element>>;
+
+template <typename Element>
+using PrefetchTarget =
+    std::conditional_t<kPrefetchPointee<Element>, std::remove_pointer_t<Element>, Element>;
+
+template <typename Element>
+void PrefetchElement(const Element& element) noexcept {
+    if constexpr (kPrefetchPointee<Element>) {
+        PrefetchObject(element);
+    } else {
+        PrefetchObject(std::addressof(element));
+    }
+}
+
+template <typename It>
+using IteratorElement = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<It>())>>;
+
+}  // namespace detail
+
+// Расстояние предвыборки в шагах для объектов типа Target: сколько объектов
+// помещается в окно kPrefetchWindowBytes, но не меньше 4 и не больше 32.
+// Для void берётся наибольшее расстояние
+template <typename Target>
+constexpr size_t DefaultPrefetchDistance() noexcept {
+    if constexpr (std::is_void_v<Target>) {
+        return detail::kMaxPrefetchDistance;
+    } else {
+        return std::clamp(detail::kPrefetchWindowBytes / sizeof(Target),
+                          detail::kMinPrefetchDistance, detail::kMaxPrefetchDistance);
+    }
+}
+
+// Вызывает fn(*it) для каждого it из [first, last) по порядку. Для элемента,
+// отстоящего на distance шагов вперёд, заранее запрашивается объект, на
+// который он указывает, если элементы — указатели, или сам элемент иначе.
+// Возвращает fn, как std::for_each
+template <typename ForwardIt, typename Fn>
+Fn ForEachPrefetched(ForwardIt first, ForwardIt last, Fn fn, size_t distance = 0) {
+    using Element = detail::IteratorElement<ForwardIt>;
+    if (distance == 0) {
+        distance = DefaultPrefetchDistance<detail::PrefetchTarget<Element>>();
+    }
+
+    ForwardIt ahead = first;
+    for (size_t i = 0; i < distance && ahead != last; ++i, ++ahead) {
+        detail::PrefetchElement(*ahead);
+    }
+    for (; ahead != last; ++first, ++ahead) {
+        detail::PrefetchElement(*ahead);
+        fn(*first);
+    }
+    for (; first != last; ++first) {
+        fn(*first);
+    }
+
+    return fn;
+}
+
+// То же для контейнера с begin() и end(): SimpleVector, SimpleVectorView и др.
+template <typename Container, typename Fn>
+Fn ForEachPrefetched(Container&& container, Fn fn, size_t distance = 0) {
+    using std::begin;
+    using std::end;
+    return ForEachPrefetched(begin(container), end(container), std::move(fn), distance);
+}
+
+// Записывает в out элементы source[*it] для каждого индекса it из
+// [first, last), заранее запрашивая элемент таблицы, нужный через distance
+// шагов. source должен поддерживать operator[] и хранить элементы по их
+// адресам (SimpleVector, SimpleVectorView, массив). Возвращает итератор за
+// последним записанным элементом
+template <typename Source, typename ForwardIt, typename OutputIt>
+OutputIt Gather(const Source& source, ForwardIt first, ForwardIt last, OutputIt out,
+                size_t distance = 0) {
+    using Element = std::remove_cv_t<std::remove_reference_t<decltype(source[*first])>>;
+    if (distance == 0) {
+        distance = DefaultPrefetchDistance<Element>();
+    }
+
+    ForwardIt ahead = first;
+    for (size_t i = 0; i < distance && ahead != last; ++i, ++ahead) {
+        detail::PrefetchObject(std::addressof(source[*ahead]));
+    }
+    for (; ahead != last; ++first, ++ahead, ++out) {
+        detail::PrefetchObject(std::addressof(source[*ahead]));
+        *out = source[*first];
+    }
+    for (; first != last; ++first, ++out) {
+        *out = source[*first];
+    }
+
+    return out;
+}
+
+// То же для контейнера индексов
+template <typename Source, typename Indices, typename OutputIt>
+OutputIt Gather(const Source& source, const Indices& indices, OutputIt out,
+                size_t distance = 0) {
+    using std::begin;
+    using std::end;
+    return Gather(source, begin(indices), end(indices), out, distance);
+}
@@ -0,0 +1,441 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "array_ptr.h"
+#include "simple_vector_view.h"
+
+namespace detail {
+
+// Наименьшая степень двойки, не меньшая value.
+// Выбрасывает исключение std::invalid_argument, если value == 0, и
+// std::length_error, если степень двойки не помещается в size_t
+inline size_t RingCapacity(size_t value) {
+    if (value == 0) {
+        throw std::invalid_argument("Ring buffer capacity must be positive");
+    }
+    size_t capacity = 1;
+    while (capacity < value) {
+        if (capacity > std::numeric_limits<size_t>::max() / 2) {
+            throw std::length_error("Ring buffer capacity is too large");
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+}  // namespace detail
+
+// Кольцевой буфер фиксированной вместимости, округлённой вверх до степени
+// двойки. Память выделяется один раз в конструкторе. PushBack в заполненный
+// буфер вытесняет самый старый элемент, PopFront выполняется за O(1), индекс
+// элемента переводится в позицию буфера маской
+template <typename Type, typename Allocator = std::allocator<Type>>
+class RingBuffer {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    template <bool Const>
+    class BasicIterator;
+
+public:
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    // Выделяет буфер хотя бы под capacity элементов.
+    // Выбрасывает исключение std::invalid_argument, если capacity == 0
+    explicit RingBuffer(size_t capacity, const Allocator& alloc = Allocator())
+        : items_(detail::RingCapacity(capacity), alloc), mask_(items_.GetSize() - 1) {
+    }
+
+    RingBuffer(const RingBuffer& other)
+        : items_(other.GetCapacity(), AllocTraits::select_on_container_copy_construction(
+                                          other.items_.GetAllocator())),
+          mask_(other.mask_) {
+        for (const Type& item : other) {
+            PushBack(item);
+        }
+    }
+
+    // Перемещённый буфер остаётся без памяти с нулевой вместимостью:
+    // добавление в него выбрасывает исключение, его можно разрушить или
+    // присвоить
+    RingBuffer(RingBuffer&& other) noexcept
+        : items_(std::move(other.items_)),
+          mask_(std::exchange(other.mask_, 0)),
+          head_(std::exchange(other.head_, 0)),
+          size_(std::exchange(other.size_, 0)) {
+    }
+
+    RingBuffer& operator=(const RingBuffer& rhs) {
+        if (this != &rhs) {
+            RingBuffer temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    RingBuffer& operator=(RingBuffer&& rhs) noexcept {
+        if (this != &rhs) {
+            RingBuffer temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~RingBuffer() {
+        Clear();
+    }
+
+    // Создаёт элемент из args в конце. Если буфер заполнен, самый старый
+    // элемент удаляется. Возвращает ссылку на созданный элемент.
+    // Выбрасывает исключение std::logic_error, если у буфера нет памяти
+    // после перемещения
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (IsFull()) {
+            if (GetCapacity() == 0) {
+                throw std::logic_error("RingBuffer has no storage after move");
+            }
+            // args могут ссылаться на вытесняемый элемент
+            Type value(std::forward<Args>(args)...);
+            PopFront();
+            return EmplaceBack(std::move(value));
+        }
+        Type* slot = Slot(size_);
+        AllocTraits::construct(items_.GetAllocator(), slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Удаляет самый старый элемент. Буфер не должен быть пустым
+    void PopFront() noexcept {
+        assert(!IsEmpty());
+        AllocTraits::destroy(items_.GetAllocator(), Slot(0));
+        head_ = (head_ + 1) & mask_;
+        --size_;
+    }
+
+    // Удаляет самый новый элемент. Буфер не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        AllocTraits::destroy(items_.GetAllocator(), Slot(size_));
+    }
+
+    void Clear() noexcept {
+        while (!IsEmpty()) {
+            PopBack();
+        }
+        head_ = 0;
+    }
+
+    void swap(RingBuffer& other) noexcept {
+        items_.swap(other.items_);
+        std::swap(mask_, other.mask_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t GetSize() const noexcept { return size_; }
+
+    size_t GetCapacity() const noexcept { return items_.GetSize(); }
+
+    bool IsEmpty() const noexcept { return size_ == 0; }
+
+    bool IsFull() const noexcept { return size_ == GetCapacity(); }
+
+    // Возвращает ссылку на элемент с индексом index, считая от самого старого
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *Slot(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return *Slot(index);
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+        return *Slot(index);
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+        return *Slot(index);
+    }
+
+    Type& Front() noexcept { return (*this)[0]; }
+
+    const Type& Front() const noexcept { return (*this)[0]; }
+
+    Type& Back() noexcept { return (*this)[size_ - 1]; }
+
+    const Type& Back() const noexcept { return (*this)[size_ - 1]; }
+
+    // Возвращает элементы от старых к новым двумя непрерывными кусками:
+    // от начала содержимого до конца буфера и от начала буфера. Второй кусок
+    // пуст, если содержимое не переходит через конец буфера
+    std::pair<SimpleVectorView<const Type>, SimpleVectorView<const Type>> GetSegments()
+        const noexcept {
+        const size_t first = std::min(size_, GetCapacity() - head_);
+        return {SimpleVectorView<const Type>(items_.Get() + head_, first),
+                SimpleVectorView<const Type>(items_.Get(), size_ - first)};
+    }
+
+    // Итераторная область
+    Iterator begin() noexcept { return Iterator(this, 0); }
+
+    Iterator end() noexcept { return Iterator(this, size_); }
+
+    ConstIterator begin() const noexcept { return ConstIterator(this, 0); }
+
+    ConstIterator end() const noexcept { return ConstIterator(this, size_); }
+
+    ConstIterator cbegin() const noexcept { return begin(); }
+
+    ConstIterator cend() const noexcept { return end(); }
+
+private:
+    Type* Slot(size_t index) const noexcept {
+        return items_.Get() + ((head_ + index) & mask_);
+    }
+
+    ArrayPtr<Type, Allocator> items_;
+    size_t mask_;
+    // Позиция самого старого элемента в буфере
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+// Итератор произвольного доступа от самого старого элемента к самому новому
+template <typename Type, typename Allocator>
+template <bool Const>
+class RingBuffer<Type, Allocator>::BasicIterator {
+    using Owner = std::conditional_t<Const, const RingBuffer, RingBuffer>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, const Type&, Type&>;
+    using pointer = std::conditional_t<Const, const Type*, Type*>;
+
+    BasicIterator() noexcept = default;
+
+    BasicIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner), index_(index) {
+    }
+
+    // Изменяющий итератор преобразуется в константный
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+        : owner_(other.owner_), index_(other.index_) {
+    }
+
+    reference operator*() const noexcept { return (*owner_)[index_]; }
+
+    pointer operator->() const noexcept { return &(*owner_)[index_]; }
+
+    reference operator[](difference_type offset) const noexcept {
+        return (*owner_)[index_ + offset];
+    }
+
+    BasicIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+        BasicIterator copy = *this;
+        ++index_;
+        return copy;
+    }
+
+    BasicIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    BasicIterator operator--(int) noexcept {
+        BasicIterator copy = *this;
+        --index_;
+        return copy;
+    }
+
+    BasicIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    BasicIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const BasicIterator& lhs,
+                                     const BasicIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) -
+               static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ <= rhs.index_;
+    }
+
+    friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ > rhs.index_;
+    }
+
+    friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ >= rhs.index_;
+    }
+
+private:
+    template <bool>
+    friend class BasicIterator;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
+
+// Кольцевой буфер для одного потока-производителя и одного
+// потока-потребителя без блокировок. TryPush и TryEmplace вызывает только
+// производитель, TryPop — только потребитель. Курсоры производителя
+// и потребителя растут монотонно и лежат на разных кэш-линиях вместе с
+// копией чужого курсора, которая обновляется, только когда буфер кажется
+// полным или пустым. В отличие от RingBuffer, заполненный буфер не
+// вытесняет элементы: TryPush возвращает false
+template <typename Type, typename Allocator = std::allocator<Type>>
+class SpscRingBuffer {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    static constexpr size_t kCacheLineSize = 64;
+
+    // Выделяет буфер хотя бы под capacity элементов.
+    // Выбрасывает исключение std::invalid_argument, если capacity == 0
+    explicit SpscRingBuffer(size_t capacity, const Allocator& alloc = Allocator())
+        : items_(detail::RingCapacity(capacity), alloc), mask_(items_.GetSize() - 1) {
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // Разрушает оставшиеся элементы. Другие потоки не должны обращаться
+    // к буферу
+    ~SpscRingBuffer() {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        for (size_t head = head_.load(std::memory_order_relaxed); head != tail; ++head) {
+            AllocTraits::destroy(items_.GetAllocator(), items_.Get() + (head & mask_));
+        }
+    }
+
+    // Создаёт элемент из args в конце. Возвращает false, если буфер заполнен
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        AllocTraits::construct(items_.GetAllocator(), items_.Get() + (tail & mask_),
+                               std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPush(const Type& item) {
+        return TryEmplace(item);
+    }
+
+    bool TryPush(Type&& item) {
+        return TryEmplace(std::move(item));
+    }
+
+    // Перемещает самый старый элемент в out и удаляет его из буфера.
+    // Возвращает false, если буфер пуст
+    bool TryPop(Type& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        Type* slot = items_.Get() + (head & mask_);
+        out = std::move(*slot);
+        AllocTraits::destroy(items_.GetAllocator(), slot);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Возвращает число элементов. Из потока, который не владеет ни одним
+    // курсором, результат приблизителен
+    size_t GetSize() const noexcept {
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    bool IsEmpty() const noexcept { return GetSize() == 0; }
+
+    size_t GetCapacity() const noexcept { return mask_ + 1; }
+
+private:
+    ArrayPtr<Type, Allocator> items_;
+    size_t mask_;
+    // Курсор потребителя и его копия курсора производителя
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+    // Курсор производителя и его копия курсора потребителя
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+};
@@ -0,0 +1,467 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "array_ptr.h"
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+#include "uninitialized_memory.h"
+
+namespace detail {
+
+// Наибольшая степень двойки, не превышающая value (value > 0)
+constexpr size_t FloorPowerOfTwo(size_t value) noexcept {
+    size_t power = 1;
+    while (power <= value / 2) {
+        power *= 2;
+    }
+    return power;
+}
+
+// Размер куска по умолчанию: около 4 КиБ, но не меньше одного элемента
+template <typename Type>
+inline constexpr size_t kDefaultSegmentSize =
+    FloorPowerOfTwo(std::max<size_t>(4096 / sizeof(Type), 1));
+
+}  // namespace detail
+
+// Вектор, хранящий элементы в кусках по ChunkSize элементов. Таблица кусков —
+// это SimpleVector указателей на куски, поэтому рост вектора выделяет только
+// новый кусок и никогда не переносит уже созданные элементы: ссылки на
+// элементы и итераторы остаются действительными при добавлении в конец.
+// Задержка PushBack не зависит от размера вектора (кроме редкого роста
+// таблицы кусков), а пик памяти при росте не превышает одного куска.
+// ChunkSize должен быть степенью двойки: индекс элемента делится на номер
+// куска и смещение сдвигом и маской
+template <typename Type, size_t ChunkSize = detail::kDefaultSegmentSize<Type>,
+          typename Allocator = std::allocator<Type>>
+class SegmentedSimpleVector {
+    static_assert(ChunkSize != 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                  "ChunkSize must be a power of two");
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using Chunk = ArrayPtr<Type, Allocator>;
+
+    template <bool Const>
+    class BasicIterator;
+
+public:
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    static constexpr size_t kChunkSize = ChunkSize;
+
+    SegmentedSimpleVector() noexcept(noexcept(Allocator())) = default;
+
+    explicit SegmentedSimpleVector(const Allocator& alloc) noexcept
+        : alloc_(alloc) {
+    }
+
+    // Создаёт вектор из size копий value
+    SegmentedSimpleVector(size_t size, const Type& value,
+                          const Allocator& alloc = Allocator())
+        : SegmentedSimpleVector(alloc) {
+        Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(value);
+        }
+    }
+
+    SegmentedSimpleVector(std::initializer_list<Type> init,
+                          const Allocator& alloc = Allocator())
+        : SegmentedSimpleVector(alloc) {
+        Reserve(init.size());
+        for (const Type& item : init) {
+            PushBack(item);
+        }
+    }
+
+    // Копия выделяет только куски, необходимые для её размера
+    SegmentedSimpleVector(const SegmentedSimpleVector& other)
+        : SegmentedSimpleVector(
+              AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+        Reserve(other.size_);
+        for (const Type& item : other) {
+            PushBack(item);
+        }
+    }
+
+    SegmentedSimpleVector(SegmentedSimpleVector&& other) noexcept
+        : alloc_(std::move(other.alloc_)),
+          chunks_(std::move(other.chunks_)),
+          size_(std::exchange(other.size_, 0)) {
+    }
+
+    // Присваивание через копию: аллокатор копируется вместе с кусками
+    SegmentedSimpleVector& operator=(const SegmentedSimpleVector& rhs) {
+        if (this != &rhs) {
+            SegmentedSimpleVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SegmentedSimpleVector& operator=(SegmentedSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SegmentedSimpleVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~SegmentedSimpleVector() {
+        Clear();
+    }
+
+    // Создаёт элемент из args в конце вектора и возвращает ссылку на него.
+    // Если места нет, выделяет один новый кусок
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            AddChunk();
+        }
+        Type* slot = SlotAt(size_);
+        AllocTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Удаляет последний элемент. Вектор не должен быть пустым. Куски не
+    // освобождаются
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        AllocTraits::destroy(alloc_, SlotAt(size_));
+    }
+
+    // Выделяет куски, чтобы вместить new_capacity элементов
+    // Выбрасывает исключение std::length_error, если new_capacity > GetMaxSize()
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetMaxSize()) {
+            throw std::length_error("SegmentedSimpleVector capacity exceeds max size");
+        }
+        const size_t chunks = (new_capacity + ChunkSize - 1) / ChunkSize;
+        if (chunks > chunks_.GetSize()) {
+            chunks_.Reserve(chunks);
+            while (chunks_.GetSize() < chunks) {
+                AddChunk();
+            }
+        }
+    }
+
+    // Изменяет размер. Новые элементы получают значение по умолчанию
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyRange(new_size, size_);
+            size_ = new_size;
+            return;
+        }
+        Reserve(new_size);
+        while (size_ < new_size) {
+            EmplaceBack();
+        }
+    }
+
+    // Разрушает все элементы. Куски сохраняются для повторного заполнения,
+    // если release_memory не равен true
+    void Clear(bool release_memory = false) noexcept {
+        DestroyRange(0, size_);
+        size_ = 0;
+        if (release_memory) {
+            chunks_.Clear(true);
+        }
+    }
+
+    // Освобождает куски, в которых нет элементов
+    void ShrinkToFit() noexcept {
+        const size_t used = (size_ + ChunkSize - 1) / ChunkSize;
+        while (chunks_.GetSize() > used) {
+            chunks_.PopBack();
+        }
+    }
+
+    void swap(SegmentedSimpleVector& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
+        chunks_.swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t GetSize() const noexcept { return size_; }
+
+    // Возвращает число элементов, помещающихся в выделенные куски
+    size_t GetCapacity() const noexcept { return chunks_.GetSize() * ChunkSize; }
+
+    bool IsEmpty() const noexcept { return size_ == 0; }
+
+    size_t GetMaxSize() const noexcept {
+        return std::min(AllocTraits::max_size(alloc_) / ChunkSize,
+                        chunks_.GetMaxSize()) * ChunkSize;
+    }
+
+    Allocator GetAllocator() const noexcept { return alloc_; }
+
+    // Возвращает число кусков, содержащих элементы
+    size_t GetChunkCount() const noexcept { return (size_ + ChunkSize - 1) / ChunkSize; }
+
+    // Возвращает представление элементов куска index. Все куски, кроме
+    // последнего, заполнены полностью
+    SimpleVectorView<Type> ChunkView(size_t index) noexcept {
+        assert(index < GetChunkCount());
+        return SimpleVectorView<Type>(chunks_[index].Get(), ChunkLength(index));
+    }
+
+    SimpleVectorView<const Type> ChunkView(size_t index) const noexcept {
+        assert(index < GetChunkCount());
+        return SimpleVectorView<const Type>(chunks_[index].Get(), ChunkLength(index));
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *SlotAt(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return *SlotAt(index);
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+        return *SlotAt(index);
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+        return *SlotAt(index);
+    }
+
+    // Итераторная область. Итератор хранит вектор и индекс, поэтому остаётся
+    // действительным при добавлении элементов
+    Iterator begin() noexcept { return Iterator(this, 0); }
+
+    Iterator end() noexcept { return Iterator(this, size_); }
+
+    ConstIterator begin() const noexcept { return ConstIterator(this, 0); }
+
+    ConstIterator end() const noexcept { return ConstIterator(this, size_); }
+
+    ConstIterator cbegin() const noexcept { return begin(); }
+
+    ConstIterator cend() const noexcept { return end(); }
+
+private:
+    static constexpr size_t kChunkShift = [] {
+        size_t shift = 0;
+        while ((size_t{1} << shift) != ChunkSize) {
+            ++shift;
+        }
+        return shift;
+    }();
+
+    Type* SlotAt(size_t index) const noexcept {
+        return chunks_[index >> kChunkShift].Get() + (index & (ChunkSize - 1));
+    }
+
+    size_t ChunkLength(size_t index) const noexcept {
+        return std::min(ChunkSize, size_ - index * ChunkSize);
+    }
+
+    void AddChunk() {
+        if (GetCapacity() > GetMaxSize() - ChunkSize) {
+            throw std::length_error("SegmentedSimpleVector capacity exceeds max size");
+        }
+        chunks_.EmplaceBack(ChunkSize, alloc_);
+    }
+
+    // Разрушает элементы [first, last) по кускам
+    void DestroyRange(size_t first, size_t last) noexcept {
+        while (first != last) {
+            const size_t chunk_end = std::min(last, (first / ChunkSize + 1) * ChunkSize);
+            Type* slot = SlotAt(first);
+            detail::Destroy(alloc_, slot, slot + (chunk_end - first));
+            first = chunk_end;
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_;
+    SimpleVector<Chunk> chunks_;
+    size_t size_ = 0;
+};
+
+// Итератор произвольного доступа по элементам всех кусков
+template <typename Type, size_t ChunkSize, typename Allocator>
+template <bool Const>
+class SegmentedSimpleVector<Type, ChunkSize, Allocator>::BasicIterator {
+    using Owner = std::conditional_t<Const, const SegmentedSimpleVector, SegmentedSimpleVector>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, const Type&, Type&>;
+    using pointer = std::conditional_t<Const, const Type*, Type*>;
+
+    BasicIterator() noexcept = default;
+
+    BasicIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner), index_(index) {
+    }
+
+    // Изменяющий итератор преобразуется в константный
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+        : owner_(other.owner_), index_(other.index_) {
+    }
+
+    reference operator*() const noexcept { return (*owner_)[index_]; }
+
+    pointer operator->() const noexcept { return &(*owner_)[index_]; }
+
+    reference operator[](difference_type offset) const noexcept {
+        return (*owner_)[index_ + offset];
+    }
+
+    BasicIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+        BasicIterator copy = *this;
+        ++index_;
+        return copy;
+    }
+
+    BasicIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    BasicIterator operator--(int) noexcept {
+        BasicIterator copy = *this;
+        --index_;
+        return copy;
+    }
+
+    BasicIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    BasicIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const BasicIterator& lhs,
+                                     const BasicIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) -
+               static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ <= rhs.index_;
+    }
+
+    friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ > rhs.index_;
+    }
+
+    friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ >= rhs.index_;
+    }
+
+private:
+    template <bool>
+    friend class BasicIterator;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
+
+template <typename Type, size_t ChunkSize, typename Allocator>
+bool operator==(const SegmentedSimpleVector<Type, ChunkSize, Allocator>& lhs,
+                const SegmentedSimpleVector<Type, ChunkSize, Allocator>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t ChunkSize, typename Allocator>
+bool operator!=(const SegmentedSimpleVector<Type, ChunkSize, Allocator>& lhs,
+                const SegmentedSimpleVector<Type, ChunkSize, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t ChunkSize, typename Allocator>
+bool operator<(const SegmentedSimpleVector<Type, ChunkSize, Allocator>& lhs,
+               const SegmentedSimpleVector<Type, ChunkSize, Allocator>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t ChunkSize, typename Allocator>
+bool operator<=(const SegmentedSimpleVector<Type, ChunkSize, Allocator>& lhs,
+                const SegmentedSimpleVector<Type, ChunkSize, Allocator>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t ChunkSize, typename Allocator>
+bool operator>(const SegmentedSimpleVector<Type, ChunkSize, Allocator>& lhs,
+               const SegmentedSimpleVector<Type, ChunkSize, Allocator>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t ChunkSize, typename Allocator>
+bool operator>=(const SegmentedSimpleVector<Type, ChunkSize, Allocator>& lhs,
+                const SegmentedSimpleVector<Type, ChunkSize, Allocator>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cpu_features.h"
+
+// Векторизованное сравнение массивов арифметических типов.
+// Целые числа равны тогда и только тогда, когда равны их байты, поэтому для
+// них равенство сводится к memcmp, а первое различие ищется побайтово.
+// Для float и double равенство проверяется инструкциями сравнения чисел:
+// так -0.0 == 0.0, а NaN не равен ничему, как и при сравнении через ==
+namespace detail {
+
+template <typename Type>
+inline constexpr bool kIsBitwiseComparable = std::is_integral_v<Type>;
+
+template <typename Type>
+inline constexpr bool kHasSimdCompare =
+    kIsBitwiseComparable<Type> || std::is_same_v<Type, float> ||
+    std::is_same_v<Type, double>;
+
+inline size_t CountTrailingZeros(uint32_t mask) noexcept {
+    return static_cast<size_t>(__builtin_ctz(mask));
+}
+
+// Возвращает индекс первого различающегося байта или size
+inline size_t MismatchBytesScalar(const unsigned char* lhs, const unsigned char* rhs,
+                                  size_t size) noexcept {
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t a;
+        uint64_t b;
+        std::memcpy(&a, lhs + i, sizeof(a));
+        std::memcpy(&b, rhs + i, sizeof(b));
+        if (a != b) {
+            break;
+        }
+    }
+    for (; i < size; ++i) {
+        if (lhs[i] != rhs[i]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+// Возвращает индекс первого элемента, для которого !(lhs[i] == rhs[i]), или size
+template <typename Type>
+size_t MismatchFloatingScalar(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    for (size_t i = 0; i < size; ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return i;
+        }
+    }
+    return size;
+}
+
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD) && defined(__SSE2__)
+
+inline size_t MismatchBytesSse2(const unsigned char* lhs, const unsigned char* rhs,
+                                size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+        const uint32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+        if (equal != 0xFFFF) {
+            return i + CountTrailingZeros(~equal);
+        }
+    }
+    return i + MismatchBytesScalar(lhs + i, rhs + i, size - i);
+}
+
+inline size_t MismatchFloatSse2(const float* lhs, const float* rhs, size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        const uint32_t equal =
+            _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i)));
+        if (equal != 0xF) {
+            return i + CountTrailingZeros(~equal);
+        }
+    }
+    return i + MismatchFloatingScalar(lhs + i, rhs + i, size - i);
+}
+
+inline size_t MismatchDoubleSse2(const double* lhs, const double* rhs,
+                                 size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        const uint32_t equal =
+            _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+        if (equal != 0x3) {
+            return i + CountTrailingZeros(~equal);
+        }
+    }
+    return i + MismatchFloatingScalar(lhs + i, rhs + i, size - i);
+}
+
+#endif
+
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+
+SIMPLE_VECTOR_TARGET_AVX2
+inline size_t MismatchBytesAvx2(const unsigned char* lhs, const unsigned char* rhs,
+                                size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+        const uint32_t equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+        if (equal != 0xFFFFFFFF) {
+            return i + CountTrailingZeros(~equal);
+        }
+    }
+    return i + MismatchBytesScalar(lhs + i, rhs + i, size - i);
+}
+
+SIMPLE_VECTOR_TARGET_AVX2
+inline size_t MismatchFloatAvx2(const float* lhs, const float* rhs, size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m256 equal_mask =
+            _mm256_cmp_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i), _CMP_EQ_OQ);
+        const uint32_t equal = _mm256_movemask_ps(equal_mask);
+        if (equal != 0xFF) {
+            return i + CountTrailingZeros(~equal);
+        }
+    }
+    return i + MismatchFloatingScalar(lhs + i, rhs + i, size - i);
+}
+
+SIMPLE_VECTOR_TARGET_AVX2
+inline size_t MismatchDoubleAvx2(const double* lhs, const double* rhs,
+                                 size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        const __m256d equal_mask =
+            _mm256_cmp_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i), _CMP_EQ_OQ);
+        const uint32_t equal = _mm256_movemask_pd(equal_mask);
+        if (equal != 0xF) {
+            return i + CountTrailingZeros(~equal);
+        }
+    }
+    return i + MismatchFloatingScalar(lhs + i, rhs + i, size - i);
+}
+
+#endif
+
+#if defined(SIMPLE_VECTOR_HAS_NEON)
+
+inline size_t MismatchBytesNeon(const unsigned char* lhs, const unsigned char* rhs,
+                                size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t equal = vceqq_u8(vld1q_u8(lhs + i), vld1q_u8(rhs + i));
+        if (vminvq_u8(equal) != 0xFF) {
+            break;
+        }
+    }
+    return i + MismatchBytesScalar(lhs + i, rhs + i, size - i);
+}
+
+inline size_t MismatchFloatNeon(const float* lhs, const float* rhs, size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        const uint32x4_t equal = vceqq_f32(vld1q_f32(lhs + i), vld1q_f32(rhs + i));
+        if (vminvq_u32(equal) != 0xFFFFFFFF) {
+            break;
+        }
+    }
+    return i + MismatchFloatingScalar(lhs + i, rhs + i, size - i);
+}
+
+inline size_t MismatchDoubleNeon(const double* lhs, const double* rhs,
+                                 size_t size) noexcept {
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        const uint64x2_t equal = vceqq_f64(vld1q_f64(lhs + i), vld1q_f64(rhs + i));
+        if ((vgetq_lane_u64(equal, 0) & vgetq_lane_u64(equal, 1)) != ~uint64_t{0}) {
+            break;
+        }
+    }
+    return i + MismatchFloatingScalar(lhs + i, rhs + i, size - i);
+}
+
+#endif
+
+// Выбирает самое широкое ядро, доступное на этом процессоре
+inline size_t MismatchBytes(const unsigned char* lhs, const unsigned char* rhs,
+                            size_t size) noexcept {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+    if (CpuHasAvx2()) {
+        return MismatchBytesAvx2(lhs, rhs, size);
+    }
+#if defined(__SSE2__)
+    return MismatchBytesSse2(lhs, rhs, size);
+#endif
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+    return MismatchBytesNeon(lhs, rhs, size);
+#endif
+    return MismatchBytesScalar(lhs, rhs, size);
+}
+
+inline size_t MismatchFloating(const float* lhs, const float* rhs, size_t size) noexcept {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+    if (CpuHasAvx2()) {
+        return MismatchFloatAvx2(lhs, rhs, size);
+    }
+#if defined(__SSE2__)
+    return MismatchFloatSse2(lhs, rhs, size);
+#endif
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+    return MismatchFloatNeon(lhs, rhs, size);
+#endif
+    return MismatchFloatingScalar(lhs, rhs, size);
+}
+
+inline size_t MismatchFloating(const double* lhs, const double* rhs,
+                               size_t size) noexcept {
+#if defined(SIMPLE_VECTOR_HAS_X86_SIMD)
+    if (CpuHasAvx2()) {
+        return MismatchDoubleAvx2(lhs, rhs, size);
+    }
+#if defined(__SSE2__)
+    return MismatchDoubleSse2(lhs, rhs, size);
+#endif
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+    return MismatchDoubleNeon(lhs, rhs, size);
+#endif
+    return MismatchFloatingScalar(lhs, rhs, size);
+}
+
+// Возвращает индекс первого элемента, для которого !(lhs[i] == rhs[i]), или size
+template <typename Type>
+size_t SimdMismatch(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    static_assert(kHasSimdCompare<Type>);
+    if constexpr (kIsBitwiseComparable<Type>) {
+        return MismatchBytes(reinterpret_cast<const unsigned char*>(lhs),
+                             reinterpret_cast<const unsigned char*>(rhs),
+                             size * sizeof(Type)) /
+               sizeof(Type);
+    } else {
+        return MismatchFloating(lhs, rhs, size);
+    }
+}
+
+// Сравнивает size элементов на равенство, как std::equal
+template <typename Type>
+bool SimdEqual(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    if (size == 0) {
+        return true;
+    }
+    if constexpr (kIsBitwiseComparable<Type>) {
+        return lhs == rhs || std::memcmp(lhs, rhs, size * sizeof(Type)) == 0;
+    } else {
+        return SimdMismatch(lhs, rhs, size) == size;
+    }
+}
+
+// Сравнивает массивы лексикографически, как std::lexicographical_compare.
+// Элементы, которые не равны, но и не упорядочены (NaN), пропускаются
+template <typename Type>
+bool SimdLexicographicalLess(const Type* lhs, size_t lhs_size, const Type* rhs,
+                             size_t rhs_size) noexcept {
+    const size_t size = std::min(lhs_size, rhs_size);
+    if constexpr (kIsBitwiseComparable<Type> && sizeof(Type) == 1 &&
+                  std::is_unsigned_v<Type>) {
+        // memcmp сравнивает байты как unsigned char, то есть в нужном порядке
+        const int order = size == 0 ? 0 : std::memcmp(lhs, rhs, size);
+        return order != 0 ? order < 0 : lhs_size < rhs_size;
+    } else {
+        size_t i = 0;
+        while (true) {
+            i += SimdMismatch(lhs + i, rhs + i, size - i);
+            if (i == size) {
+                return lhs_size < rhs_size;
+            }
+            if (lhs[i] < rhs[i]) {
+                return true;
+            }
+            if (rhs[i] < lhs[i]) {
+                return false;
+            }
+            ++i;
+        }
+    }
+}
+
+// Сравнивает непрерывные массивы, выбирая векторизованное ядро для
+// арифметических типов и стандартные алгоритмы для остальных
+template <typename Type>
+bool ContiguousEqual(const Type* lhs, const Type* rhs, size_t size) {
+    if constexpr (kHasSimdCompare<Type>) {
+        return SimdEqual(lhs, rhs, size);
+    } else {
+        return std::equal(lhs, lhs + size, rhs);
+    }
+}
+
+template <typename Type>
+bool ContiguousLess(const Type* lhs, size_t lhs_size, const Type* rhs,
+                    size_t rhs_size) {
+    if constexpr (kHasSimdCompare<Type>) {
+        return SimdLexicographicalLess(lhs, lhs_size, rhs, rhs_size);
+    } else {
+        return std::lexicographical_compare(lhs, lhs + lhs_size, rhs, rhs + rhs_size);
+    }
+}
+
+}  // namespace detail
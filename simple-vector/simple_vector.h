@@ -3,11 +3,24 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <vector>
 
+#include "aligned_allocator.h"
 #include "array_ptr.h"
+#include "constexpr_support.h"
+#include "growth_policy.h"
+#include "parallel.h"
+#include "simd_compare.h"
+#include "uninitialized_memory.h"
+#include "vector_stats.h"
 
 struct ReserveProxyObj {
     ReserveProxyObj(size_t cpacity_to_reserve) : capacity(cpacity_to_reserve) {}
@@ -15,204 +28,606 @@ struct ReserveProxyObj {
     size_t capacity;
 };
 
+// Буфер, отданный вектором через Release: память под capacity элементов,
+// первые size из которых созданы. Владелец должен разрушить элементы и
+// вернуть память тому же аллокатору
 template <typename Type>
+struct SimpleVectorBuffer {
+    Type* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+// Вектор, хранящий элементы в памяти, выделенной аллокатором Allocator.
+// Распространение аллокатора при копировании, перемещении и обмене следует
+// std::allocator_traits, как у стандартных контейнеров.
+// При перевыделении памяти элементы перемещаются, если их перемещающий
+// конструктор noexcept, и копируются иначе. Поэтому Reserve, Resize, PushBack,
+// EmplaceBack и вставка, потребовавшие перевыделения, дают строгую гарантию
+// исключений для копируемых типов.
+// GrowthPolicy выбирает новую вместимость при нехватке места (см. growth_policy.h).
+// Если аллокатор умеет увеличивать буфер на месте (см. MmapAllocator), рост
+// сначала пробует его и обходится без переноса элементов.
+// При сборке с SIMPLE_VECTOR_ENABLE_STATS вектор ведёт статистику выделений и
+// переносов элементов (см. vector_stats.h).
+// В C++20 основные операции constexpr (см. constexpr_support.h): вектор можно
+// заполнить и обработать при вычислении константного выражения
+template <typename Type, typename Allocator = std::allocator<Type>,
+          typename GrowthPolicy = DoublingGrowth>
 class SimpleVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, Type>,
+                  "Allocator::value_type must be the same as Type");
+
    public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+    using GrowthPolicyType = GrowthPolicy;
+
+    // Выравнивание буфера, которое гарантирует аллокатор (см. AlignedAllocator)
+    static constexpr size_t kAlignment = detail::kAllocatorAlignment<Allocator>;
 
-    SimpleVector() noexcept = default;
+    SimpleVector() noexcept(noexcept(Allocator())) = default;
+
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(const Allocator& alloc) noexcept
+        : items_(alloc) {
+    }
 
     // Создаёт вектор из size элементов, инициализированных значением по
     // умолчанию
-    explicit SimpleVector(size_t size)
-        : size_(size), capacity_(size), items_(size) {
-        for (size_t i = 0; i < size; i++) {
-            items_[i] = Type();
-        }
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(size_t size,
+                                                  const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        stats_.OnAllocate(size);
+        detail::UninitializedValueConstruct(Alloc(), items_.Get(), size);
+        size_ = size;
     }
 
     // Создаёт вектор из size элементов, инициализированных значением value
-    SimpleVector(size_t size, const Type& value)
-        : size_(size), capacity_(size), items_(size) {
-        for (size_t i = 0; i < size_; i++) {
-            items_[i] = value;
-        }
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, const Type& value,
+                                         const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        stats_.OnAllocate(size);
+        detail::UninitializedFill(Alloc(), items_.Get(), size, value);
+        stats_.OnCopy(size);
+        size_ = size;
     }
-    
+
     // Создаёт вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init)
-        : size_(init.size()), capacity_(init.size()), items_(init.size()) {
-        std::copy(init.begin(), init.end(), begin());
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(std::initializer_list<Type> init,
+                                         const Allocator& alloc = Allocator())
+        : items_(init.size(), alloc) {
+        stats_.OnAllocate(init.size());
+        detail::UninitializedCopy(Alloc(), init.begin(), init.end(), items_.Get());
+        stats_.OnCopy(init.size());
+        size_ = init.size();
     }
 
-    // Копирующий конструткор
-    SimpleVector(const SimpleVector& other)
-        : size_(other.size_),
-          capacity_(other.capacity_),
-          items_(other.size_) {
-        std::copy(other.begin(), other.end(), begin());
+    // Копирующий конструткор. Вместимость копии равна размеру оригинала,
+    // аллокатор выбирается select_on_container_copy_construction
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other)
+        : SimpleVector(other, AllocTraits::select_on_container_copy_construction(
+                                  other.items_.GetAllocator())) {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other, const Allocator& alloc)
+        : items_(other.size_, alloc) {
+        stats_.OnAllocate(other.size_);
+        detail::UninitializedCopy(Alloc(), other.begin(), other.end(), items_.Get());
+        stats_.OnCopy(other.size_);
+        size_ = other.size_;
     }
 
     // Конструктор перемещения
-    SimpleVector(SimpleVector&& moved) noexcept
-        : size_(std::exchange(moved.size_, 0)),
-          capacity_(std::exchange(moved.capacity_, 0)) {
-        items_.swap(moved.items_);
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& moved) noexcept
+        : items_(std::move(moved.items_)),
+          size_(std::exchange(moved.size_, 0)) {
+    }
+
+    // Конструктор перемещения с заданным аллокатором. Если аллокаторы
+    // не равны, элементы перемещаются по одному в новую память
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& moved, const Allocator& alloc)
+        : items_(alloc) {
+        if (alloc == moved.items_.GetAllocator()) {
+            items_ = std::move(moved.items_);
+            size_ = std::exchange(moved.size_, 0);
+        } else {
+            ArrayPtr<Type, Allocator> new_items(moved.size_, alloc);
+            stats_.OnAllocate(moved.size_);
+            detail::UninitializedMove(new_items.GetAllocator(), moved.begin(),
+                                      moved.end(), new_items.Get());
+            stats_.OnMove(moved.size_);
+            items_ = std::move(new_items);
+            size_ = moved.size_;
+        }
     }
 
-    // Конструктор резервирования
-    SimpleVector(const ReserveProxyObj& reserved)
-        : capacity_(reserved.capacity), items_(reserved.capacity) {}
+    // Создаёт вектор из size копий value, заполняя куски буфера параллельно
+    // (см. ParallelPolicy). Аллокатор должен допускать одновременные вызовы
+    // construct из разных потоков
+    SimpleVector(const ParallelPolicy& policy, size_t size, const Type& value,
+                 const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        stats_.OnAllocate(size);
+        Type* data = items_.Get();
+        detail::ParallelConstruct(policy, Alloc(), data, size,
+                                  [this, data, &value](size_t first, size_t last) {
+                                      detail::UninitializedFill(Alloc(), data + first,
+                                                                last - first, value);
+                                  });
+        stats_.OnCopy(size);
+        size_ = size;
+    }
 
-    SimpleVector& operator=(const SimpleVector& rhs) {
+    // Создаёт вектор из size элементов generator(0), ..., generator(size - 1).
+    // Элементы создаются параллельно, поэтому generator вызывается из разных
+    // потоков одновременно и порядок вызовов не определён
+    template <typename Generator,
+              typename = std::enable_if_t<
+                  std::is_invocable_v<const Generator&, size_t> &&
+                  !std::is_convertible_v<const Generator&, const Type&>>>
+    SimpleVector(const ParallelPolicy& policy, size_t size, const Generator& generator,
+                 const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        stats_.OnAllocate(size);
+        Type* data = items_.Get();
+        detail::ParallelConstruct(
+            policy, Alloc(), data, size, [this, data, &generator](size_t first, size_t last) {
+                size_t current = first;
+                try {
+                    for (; current != last; ++current) {
+                        AllocTraits::construct(Alloc(), data + current, generator(current));
+                    }
+                } catch (...) {
+                    detail::Destroy(Alloc(), data + first, data + current);
+                    throw;
+                }
+            });
+        stats_.OnMove(size);
+        size_ = size;
+    }
+
+    // Параллельный копирующий конструктор (см. ParallelPolicy)
+    SimpleVector(const ParallelPolicy& policy, const SimpleVector& other)
+        : items_(other.size_, AllocTraits::select_on_container_copy_construction(
+                                  other.items_.GetAllocator())) {
+        stats_.OnAllocate(other.size_);
+        Type* data = items_.Get();
+        const Type* source = other.items_.Get();
+        detail::ParallelConstruct(policy, Alloc(), data, other.size_,
+                                  [this, data, source](size_t first, size_t last) {
+                                      detail::UninitializedCopy(Alloc(), source + first,
+                                                                source + last, data + first);
+                                  });
+        stats_.OnCopy(other.size_);
+        size_ = other.size_;
+    }
+
+    // Конструктор резервирования. Выделяет память, не создавая элементов
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const ReserveProxyObj& reserved,
+                                         const Allocator& alloc = Allocator())
+        : items_(reserved.capacity, alloc) {
+        stats_.OnAllocate(reserved.capacity);
+    }
+
+    // Создаёт вектор, владеющий буфером data под capacity элементов, первые
+    // size из которых уже созданы. Элементы не копируются. Память должна быть
+    // выделена аллокатором, равным alloc, вызовом allocate(capacity): вектор
+    // вернёт её через deallocate. data может быть nullptr, только если
+    // capacity == 0
+    [[nodiscard]] static SIMPLE_VECTOR_CONSTEXPR SimpleVector Adopt(
+        Type* data, size_t size, size_t capacity, const Allocator& alloc = Allocator()) noexcept {
+        assert(size <= capacity && (data != nullptr || capacity == 0));
+        SimpleVector result(alloc);
+        result.items_ = ArrayPtr<Type, Allocator>(data, capacity, alloc);
+        result.size_ = size;
+        return result;
+    }
+
+    // Создаёт вектор, владеющий буфером, ранее отданным Release
+    [[nodiscard]] static SIMPLE_VECTOR_CONSTEXPR SimpleVector Adopt(
+        const SimpleVectorBuffer<Type>& buffer, const Allocator& alloc = Allocator()) noexcept {
+        return Adopt(buffer.data, buffer.size, buffer.capacity, alloc);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ~SimpleVector() {
+        DestroyAll();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(const SimpleVector& rhs) {
         if (this != &rhs) {
-            SimpleVector<Type> temp(rhs);
-            swap(temp);
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                SimpleVector temp(rhs, rhs.items_.GetAllocator());
+                if (Alloc() != rhs.items_.GetAllocator()) {
+                    ReleaseStorage();
+                    items_.ResetAllocator(rhs.items_.GetAllocator());
+                }
+                swap(temp);
+                stats_.Merge(temp.stats_);
+            } else {
+                SimpleVector temp(rhs, Alloc());
+                swap(temp);
+                stats_.Merge(temp.stats_);
+            }
         }
-        
+
         return *this;
     }
 
-    SimpleVector& operator=(SimpleVector&& rhs) {
-        if (this != &rhs)  {
-            SimpleVector<Type> temp(std::move(rhs));
-            swap(temp);
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(SimpleVector&& rhs) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value ||
+        AllocTraits::is_always_equal::value) {
+        if (this != &rhs) {
+            if (AllocTraits::propagate_on_container_move_assignment::value ||
+                Alloc() == rhs.items_.GetAllocator()) {
+                DestroyAll();
+                items_ = std::move(rhs.items_);
+                size_ = std::exchange(rhs.size_, 0);
+            } else {
+                SimpleVector temp(std::move(rhs), Alloc());
+                swap(temp);
+                stats_.Merge(temp.stats_);
+            }
         }
 
         return *this;
     }
 
     // Добавляет элемент в конец вектора
-    // При нехватке места увеличивает вдвое вместимость вектора
-    void PushBack(const Type& item) {
-        if (size_ == capacity_) {
-            Reserve(capacity_ == 0 ? 1 : capacity_ * 2);
-        }
-
-        *end() = item;
-        ++size_;
+    // При нехватке места увеличивает вместимость согласно GrowthPolicy
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBack(item);
+        stats_.OnCopy(1);
     }
 
     // Move PushBack
-    void PushBack(Type&& item) {
-        if (size_ == capacity_) {
-            SimpleVector<Type> temp_vector(std::max(capacity_ + 1, capacity_ * 2));
-            for (size_t i = 0; i < size_; i++) {
-                temp_vector[i] = std::move(items_[i]);
-            }
-            std::swap(capacity_, temp_vector.capacity_);
-            items_.swap(temp_vector.items_);
-        }
-
-        *end() = std::move(item);
-        ++size_;
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+        stats_.OnMove(1);
     }
 
     // Вставляет значение value в позицию pos.
     // Возвращает итератор на вставленное значение
     // Если перед вставкой значения вектор был заполнен полностью,
-    // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью
-    // 0 стать равной 1
-    Iterator Insert(ConstIterator pos, const Type& value) {
-        assert(pos >= begin() && pos <= end());
-        size_t index = pos - begin();
-        if (size_ == capacity_) {
-            SimpleVector<Type> temp_vector(std::max(capacity_ + 1, capacity_ * 2));
-            std::copy(begin(), begin() + index, temp_vector.begin());
-            temp_vector[index] = value;
-            std::copy(begin() + index, end(), temp_vector.begin() + index + 1);
-            items_.swap(temp_vector.items_);
-            std::swap(capacity_, temp_vector.capacity_);
+    // вместимость увеличивается согласно GrowthPolicy
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        Iterator it = Emplace(pos, value);
+        stats_.OnCopy(1);
+        return it;
+    }
+
+    // Move Insert
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        Iterator it = Emplace(pos, std::move(value));
+        stats_.OnMove(1);
+        return it;
+    }
+
+    // Создаёт элемент из args прямо в конце вектора, без временного объекта.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity() && !TryGrowInPlace(size_ + 1)) {
+            ReallocateAndEmplace(size_, std::forward<Args>(args)...);
         } else {
-            std::copy_backward(begin() + index, end(), end() + 1);
-            items_[index] = value;
+            AllocTraits::construct(Alloc(), end(), std::forward<Args>(args)...);
         }
         ++size_;
 
-        return Iterator(begin() + index);
+        return *(end() - 1);
     }
 
-    // Move Insert
-    Iterator Insert(ConstIterator pos, Type&& value) {
+    // Создаёт элемент из args прямо в позиции pos, сдвигая хвост вправо.
+    // Возвращает итератор на созданный элемент. При вставке в середину
+    // заполненного не до конца вектора элемент сначала создаётся во временном
+    // объекте, так как args могут ссылаться на элементы вектора
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
         assert(pos >= begin() && pos <= end());
         size_t index = pos - begin();
-        if (size_ == capacity_) {
-            SimpleVector<Type> temp_vector(std::max(capacity_ + 1, capacity_ * 2));
-            std::move(begin(), begin() + index, temp_vector.begin());
-            temp_vector[index] = std::move(value);
-            std::move(begin() + index, end(), temp_vector.begin() + index + 1);
-            items_.swap(temp_vector.items_);
-            std::swap(capacity_, temp_vector.capacity_);
+
+        if (size_ == GetCapacity() && !TryGrowInPlace(size_ + 1)) {
+            ReallocateAndEmplace(index, std::forward<Args>(args)...);
+        } else if (index == size_) {
+            AllocTraits::construct(Alloc(), end(), std::forward<Args>(args)...);
         } else {
-            std::move_backward(begin() + index, end(), end() + 1);
-            items_[index] = std::move(value);
+            Type value(std::forward<Args>(args)...);
+            detail::InsertShifted(Alloc(), begin() + index, end(), std::move(value));
+            stats_.OnMove(size_ - index + 1);
         }
         ++size_;
 
         return Iterator(begin() + index);
     }
 
-    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
-    void PopBack() noexcept {
+    // Вставляет элементы [first, last) в позицию pos.
+    // Возвращает итератор на первый вставленный элемент.
+    // Для forward-итераторов итоговый размер вычисляется заранее: память
+    // перевыделяется не более одного раза, а хвост сдвигается один раз.
+    // Input-итераторы дописываются в конец и переставляются на место.
+    // Итераторы не должны указывать внутрь вектора
+    template <typename InputIt>
+    SIMPLE_VECTOR_CONSTEXPR Iterator InsertRange(ConstIterator pos, InputIt first,
+                                                 InputIt last) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = pos - begin();
+
+        if constexpr (detail::kIsForwardIterator<InputIt>) {
+            const size_t count = std::distance(first, last);
+            if (count == 0) {
+                return begin() + index;
+            }
+
+            // Вместимость не превышает GetMaxSize(), поэтому проверка
+            // срабатывает только при нехватке места
+            if (count > GetMaxSize() - size_) {
+                throw std::length_error("SimpleVector capacity exceeds max size");
+            }
+            if (count > GetCapacity() - size_ && !TryGrowInPlace(size_ + count)) {
+                ArrayPtr<Type, Allocator> new_items(GrowCapacity(size_ + count),
+                                                    Alloc());
+                stats_.OnAllocate(new_items.GetSize());
+                Type* new_data = new_items.Get();
+                detail::UninitializedCopy(Alloc(), first, last, new_data + index);
+                try {
+                    detail::RelocateWithGap(Alloc(), begin(), end(), new_data,
+                                            index, count);
+                } catch (...) {
+                    detail::Destroy(Alloc(), new_data + index,
+                                    new_data + index + count);
+                    throw;
+                }
+                items_.swap(new_items);
+                stats_.OnReallocate();
+                RecordRelocation(size_);
+            } else {
+                detail::InsertRangeShifted(Alloc(), begin() + index, end(), first,
+                                           last, count);
+                stats_.OnMove(size_ - index);
+            }
+            stats_.OnCopy(count);
+            size_ += count;
+        } else {
+            const size_t old_size = size_;
+            try {
+                for (; first != last; ++first) {
+                    EmplaceBack(*first);
+                }
+            } catch (...) {
+                detail::Destroy(Alloc(), begin() + old_size, end());
+                size_ = old_size;
+                throw;
+            }
+            stats_.OnCopy(size_ - old_size);
+            if (index != old_size) {
+                std::rotate(begin() + index, begin() + old_size, end());
+                stats_.OnMove(size_ - index);
+            }
+        }
+
+        return begin() + index;
+    }
+
+    // Дописывает элементы [first, last) в конец вектора
+    template <typename InputIt>
+    SIMPLE_VECTOR_CONSTEXPR void Append(InputIt first, InputIt last) {
+        InsertRange(end(), first, last);
+    }
+
+    // Заменяет содержимое вектора элементами [first, last).
+    // Итераторы не должны указывать внутрь вектора
+    template <typename InputIt>
+    SIMPLE_VECTOR_CONSTEXPR void Assign(InputIt first, InputIt last) {
+        if constexpr (detail::kIsForwardIterator<InputIt>) {
+            const size_t count = std::distance(first, last);
+            if (count > GetCapacity()) {
+                ArrayPtr<Type, Allocator> new_items(CheckCapacity(count), Alloc());
+                stats_.OnAllocate(count);
+                detail::UninitializedCopy(Alloc(), first, last, new_items.Get());
+                Clear();
+                items_.swap(new_items);
+                stats_.OnReallocate();
+            } else if (count <= size_) {
+                Iterator new_end = std::copy(first, last, begin());
+                detail::Destroy(Alloc(), new_end, end());
+            } else {
+                InputIt mid = std::next(first, size_);
+                std::copy(first, mid, begin());
+                detail::UninitializedCopy(Alloc(), mid, last, end());
+            }
+            stats_.OnCopy(count);
+            size_ = count;
+        } else {
+            Clear();
+            Append(first, last);
+        }
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
         assert(!IsEmpty());
         --size_;
+        AllocTraits::destroy(Alloc(), items_.Get() + size_);
+        AutoShrink();
     }
 
     // Удаляет элемент вектора в указанной позиции
-    Iterator Erase(ConstIterator pos) {
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
         assert(pos >= begin() && pos < end());
 
         size_t index = pos - begin();
-        for (size_t i = index + 1; i < size_; ++i) {
-            items_[i - 1] = std::move(items_[i]);
-        }
+        detail::EraseShifted(Alloc(), begin() + index, end());
+        stats_.OnMove(size_ - index - 1);
         --size_;
+        AutoShrink();
 
         return Iterator(items_.Get() + index);
     }
 
+    // Удаляет элементы [first, last), сдвигая хвост один раз.
+    // Возвращает итератор на элемент, следовавший за удалёнными
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        Type* data = items_.Get();
+        detail::EraseRangeShifted(Alloc(), data + index, data + index + count,
+                                  data + size_);
+        stats_.OnMove(size_ - index - count);
+        size_ -= count;
+        AutoShrink();
+
+        return begin() + index;
+    }
+
     // Резервирует место. Повышает Capacity
-    void Reserve(size_t new_capacity) {
-        if (new_capacity > capacity_) {
-            SimpleVector<Type> temp_vector(new_capacity);
-            std::copy(begin(), end(), temp_vector.begin());
-            std::swap(capacity_, temp_vector.capacity_);
-            items_.swap(temp_vector.items_);
+    // Выбрасывает исключение std::length_error, если new_capacity > GetMaxSize()
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate(CheckCapacity(new_capacity));
+        }
+    }
+
+    // Резервирует место, перенося элементы в новый буфер параллельно
+    // (см. ParallelPolicy)
+    void Reserve(const ParallelPolicy& policy, size_t new_capacity) {
+        if (new_capacity > GetCapacity() && !items_.TryExpand(CheckCapacity(new_capacity))) {
+            ArrayPtr<Type, Allocator> new_items(new_capacity, Alloc());
+            stats_.OnAllocate(new_capacity);
+            detail::ParallelRelocate(policy, Alloc(), begin(), end(), new_items.Get());
+            items_.swap(new_items);
+            stats_.OnReallocate();
+            RecordRelocation(size_);
+        }
+    }
+
+    // Переносит элементы векторов sources[0], ..., sources[count - 1] по порядку
+    // в конец вектора и очищает их, сохраняя их вместимость. Память
+    // перевыделяется не более одного раза, результат заполняется кусками
+    // параллельно (см. ParallelPolicy). Элементы перемещаются, если их
+    // перемещение noexcept, иначе копируются: при исключении размеры всех
+    // векторов остаются прежними. sources не должны содержать этот вектор
+    void AppendMoved(const ParallelPolicy& policy, SimpleVector* const* sources,
+                     size_t count) {
+        std::vector<size_t> offsets(count + 1, 0);
+        for (size_t i = 0; i < count; ++i) {
+            assert(sources[i] != this);
+            offsets[i + 1] = offsets[i] + sources[i]->size_;
+        }
+        const size_t total = offsets[count];
+        if (total == 0) {
+            return;
+        }
+        if (total > GetMaxSize() - size_) {
+            throw std::length_error("Exceeded max size");
+        }
+
+        Reserve(policy, size_ + total);
+        Type* dest = items_.Get() + size_;
+        detail::ParallelConstruct(
+            policy, Alloc(), dest, total,
+            [this, dest, sources, &offsets](size_t first, size_t last) {
+                size_t source =
+                    std::upper_bound(offsets.begin(), offsets.end(), first) - offsets.begin() - 1;
+                size_t current = first;
+                try {
+                    for (; current != last; ++source) {
+                        const size_t chunk = std::min(last, offsets[source + 1]) - current;
+                        Type* from = sources[source]->items_.Get() + (current - offsets[source]);
+                        detail::UninitializedMoveIfNoexcept(Alloc(), from, from + chunk,
+                                                            dest + current);
+                        current += chunk;
+                    }
+                } catch (...) {
+                    detail::Destroy(Alloc(), dest + first, dest + current);
+                    throw;
+                }
+            });
+        stats_.OnMove(total);
+        size_ += total;
+        for (size_t i = 0; i < count; ++i) {
+            sources[i]->Clear();
         }
     }
 
-    // Обменивает значение с другим вектором
-    void swap(SimpleVector& other) noexcept {
+    // Уменьшает вместимость до размера вектора, возвращая лишнюю память
+    // аллокатору
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit() {
+        ShrinkTo(size_);
+    }
+
+    // Обменивает значение с другим вектором. Аллокаторы обмениваются согласно
+    // propagate_on_container_swap, иначе они должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR void swap(SimpleVector& other) noexcept {
         std::swap(size_, other.size_);
-        std::swap(capacity_, other.capacity_);
         items_.swap(other.items_);
     }
 
+    // Отдаёт буфер вместе с элементами, не разрушая их, и оставляет вектор
+    // пустым без выделенной памяти. Освободить буфер нужно аллокатором,
+    // равным GetAllocator(), или передать его в Adopt
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR SimpleVectorBuffer<Type> Release() noexcept {
+        const size_t capacity = GetCapacity();
+        const size_t size = std::exchange(size_, 0);
+        return {items_.Release(), size, capacity};
+    }
+
+    // Возвращает статистику этого вектора. Без SIMPLE_VECTOR_ENABLE_STATS все
+    // счётчики равны нулю
+    SIMPLE_VECTOR_CONSTEXPR SimpleVectorStats GetStats() const noexcept {
+        return stats_.Get();
+    }
+
+    // Возвращает копию аллокатора вектора
+    SIMPLE_VECTOR_CONSTEXPR Allocator GetAllocator() const noexcept {
+        return items_.GetAllocator();
+    }
+
     // Возвращает количество элементов в массиве
-    size_t GetSize() const noexcept { return size_; }
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept { return size_; }
 
     // Возвращает вместимость массива
-    size_t GetCapacity() const noexcept { return capacity_; }
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept { return items_.GetSize(); }
+
+    // Возвращает наибольшую вместимость, которую допускает аллокатор
+    SIMPLE_VECTOR_CONSTEXPR size_t GetMaxSize() const noexcept {
+        return AllocTraits::max_size(items_.GetAllocator());
+    }
 
     // Сообщает, пустой ли массив
-    bool IsEmpty() const noexcept { return size_ == 0; }
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept { return size_ == 0; }
+
+    // Возвращает указатель на первый элемент или nullptr, если память не
+    // выделена. Указатель выровнен хотя бы по kAlignment байт
+    SIMPLE_VECTOR_CONSTEXPR Type* Data() noexcept { return items_.Get(); }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type* Data() const noexcept { return items_.Get(); }
+
+    // Сообщает, выровнен ли буфер по границе alignment байт. alignment должен
+    // быть степенью двойки. Вектор без выделенной памяти считается выровненным
+    bool IsAligned(size_t alignment) const noexcept {
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        return (reinterpret_cast<std::uintptr_t>(items_.Get()) & (alignment - 1)) == 0;
+    }
 
     // Возвращает ссылку на элемент с индексом index
-    Type& operator[](size_t index) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
         assert(index < size_);
         return items_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
         assert(index < size_);
         return items_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    Type& At(size_t index) {
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
         if (index >= size_) {
             throw std::out_of_range("Out of range");
         }
@@ -222,7 +637,7 @@ class SimpleVector {
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    const Type& At(size_t index) const {
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
         if (index >= size_) {
             throw std::out_of_range("Out of range");
         }
@@ -230,90 +645,278 @@ class SimpleVector {
         return items_[index];
     }
 
-    // Обнуляет размер массива, не изменяя его вместимость
-    void Clear() noexcept { size_ = 0; }
+    // Разрушает все элементы. Вместимость сохраняется, если release_memory
+    // не равен true, иначе память возвращается аллокатору
+    SIMPLE_VECTOR_CONSTEXPR void Clear(bool release_memory = false) noexcept {
+        if (release_memory) {
+            ReleaseStorage();
+        } else {
+            DestroyAll();
+        }
+    }
 
     // Изменяет размер массива.
     // При увеличении размера новые элементы получают значение по умолчанию для
     // типа Type
-    void Resize(size_t new_size) {
-        if (new_size > capacity_) {
-            SimpleVector<Type> temp_vec(std::max(new_size, capacity_ * 2));
-            for (size_t i = 0; i < size_; i++) {
-                temp_vec[i] = std::move(items_[i]);
-            }
-            items_.swap(temp_vec.items_);
-            std::swap(capacity_, temp_vec.capacity_);
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            detail::Destroy(Alloc(), begin() + new_size, end());
+            size_ = new_size;
+            AutoShrink();
+            return;
         }
 
-        if (new_size > size_) {
-            for (size_t i = size_; i < new_size; ++i) {
-                items_[i] = Type();
-            }
+        if (new_size > GetCapacity() && !TryGrowInPlace(new_size)) {
+            Reallocate(GrowCapacity(new_size));
         }
 
+        detail::UninitializedValueConstruct(Alloc(), end(), new_size - size_);
         size_ = new_size;
     }
 
     // Итераторная область
-    Iterator begin() noexcept { return items_.Get(); }
-
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept { return items_.Get(); }
 
-    Iterator end() noexcept { return items_.Get() + size_; }
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept { return items_.Get() + size_; }
 
-    ConstIterator begin() const noexcept { return items_.Get(); }
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept { return items_.Get(); }
 
-    ConstIterator end() const noexcept { return items_.Get() + size_; }
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept {
+        return items_.Get() + size_;
+    }
 
-    ConstIterator cbegin() const noexcept { return items_.Get(); }
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept { return items_.Get(); }
 
-    ConstIterator cend() const noexcept { return items_.Get() + size_; }
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept {
+        return items_.Get() + size_;
+    }
 
    private:
+    SIMPLE_VECTOR_CONSTEXPR Allocator& Alloc() noexcept { return items_.GetAllocator(); }
+
+    SIMPLE_VECTOR_CONSTEXPR void DestroyAll() noexcept {
+        detail::Destroy(Alloc(), begin(), end());
+        size_ = 0;
+    }
+
+    // Разрушает элементы и возвращает память аллокатору
+    SIMPLE_VECTOR_CONSTEXPR void ReleaseStorage() noexcept {
+        DestroyAll();
+        ArrayPtr<Type, Allocator> released(std::move(items_));
+    }
+
+    // Переносит элементы в новый буфер вместимостью new_capacity
+    SIMPLE_VECTOR_CONSTEXPR void Reallocate(size_t new_capacity) {
+        if (new_capacity > GetCapacity() && items_.TryExpand(new_capacity)) {
+            return;
+        }
+        ArrayPtr<Type, Allocator> new_items(new_capacity, Alloc());
+        stats_.OnAllocate(new_capacity);
+        detail::Relocate(Alloc(), begin(), end(), new_items.Get());
+        items_.swap(new_items);
+        stats_.OnReallocate();
+        RecordRelocation(size_);
+    }
+
+    // Уменьшает вместимость до new_capacity, не меньшей размера вектора
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkTo(size_t new_capacity) {
+        assert(new_capacity >= size_);
+        if (new_capacity >= GetCapacity()) {
+            return;
+        }
+
+        if (new_capacity == 0) {
+            ReleaseStorage();
+        } else {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Уменьшает буфер, если этого требует GrowthPolicy. Уменьшение делается по
+    // возможности: если перевыделение не удалось, вектор остаётся прежним
+    SIMPLE_VECTOR_CONSTEXPR void AutoShrink() noexcept {
+        if constexpr (detail::kHasShrinkCapacity<GrowthPolicy>) {
+            const size_t new_capacity = std::max(
+                GrowthPolicy::ShrinkCapacity(size_, GetCapacity()), size_);
+            if (new_capacity < GetCapacity()) {
+                try {
+                    ShrinkTo(new_capacity);
+                } catch (...) {
+                }
+            }
+        }
+    }
+
+    // Переносит элементы в новый буфер вместимостью, выбранной GrowthPolicy,
+    // и создаёт в нём элемент из args в позиции index. Новый элемент создаётся
+    // первым: args могут ссылаться на элементы старого буфера. Размер вектора
+    // не меняется
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR void ReallocateAndEmplace(size_t index, Args&&... args) {
+        ArrayPtr<Type, Allocator> new_items(GrowCapacity(size_ + 1), Alloc());
+        stats_.OnAllocate(new_items.GetSize());
+        Type* new_data = new_items.Get();
+        AllocTraits::construct(Alloc(), new_data + index,
+                               std::forward<Args>(args)...);
+        try {
+            detail::RelocateWithGap(Alloc(), begin(), end(), new_data, index);
+        } catch (...) {
+            AllocTraits::destroy(Alloc(), new_data + index);
+            throw;
+        }
+        items_.swap(new_items);
+        stats_.OnReallocate();
+        RecordRelocation(size_);
+    }
+
+    // Учитывает в статистике перенос count элементов в новый буфер
+    SIMPLE_VECTOR_CONSTEXPR void RecordRelocation(size_t count) noexcept {
+        if constexpr (kIsTriviallyRelocatable<Type> || detail::kMoveOnRelocate<Type>) {
+            stats_.OnMove(count);
+        } else {
+            stats_.OnCopy(count);
+        }
+    }
+
+    // Увеличивает буфер на месте до вместимости, выбранной GrowthPolicy, или
+    // хотя бы до required элементов, если аллокатор это позволяет
+    SIMPLE_VECTOR_CONSTEXPR bool TryGrowInPlace(size_t required) {
+        if constexpr (detail::kHasTryExpand<Allocator>) {
+            return items_.TryExpand(GrowCapacity(required)) || items_.TryExpand(required);
+        } else {
+            return false;
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR size_t CheckCapacity(size_t capacity) const {
+        if (capacity > GetMaxSize()) {
+            throw std::length_error("SimpleVector capacity exceeds max size");
+        }
+
+        return capacity;
+    }
+
+    // Возвращает вместимость, выбранную GrowthPolicy, для хранения хотя бы
+    // required элементов
+    SIMPLE_VECTOR_CONSTEXPR size_t GrowCapacity(size_t required) const {
+        return GrowthPolicy::NextCapacity(GetCapacity(), CheckCapacity(required),
+                                          GetMaxSize(), sizeof(Type));
+    }
+
+    ArrayPtr<Type, Allocator> items_;
     size_t size_ = 0;
-    size_t capacity_ = 0;
-    ArrayPtr<Type> items_;
+    [[no_unique_address]] detail::VectorStatsRecorder<Type> stats_;
 };
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs,
-                       const SimpleVector<Type>& rhs) {
+// SimpleVector, получающий память от std::pmr::memory_resource
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+using PmrSimpleVector =
+    SimpleVector<Type, std::pmr::polymorphic_allocator<Type>, GrowthPolicy>;
+
+// SimpleVector, буфер которого при любом перевыделении выровнен по границе
+// Alignment байт
+template <typename Type, size_t Alignment = 64, typename GrowthPolicy = DoublingGrowth>
+using AlignedSimpleVector =
+    SimpleVector<Type, AlignedAllocator<Type, Alignment>, GrowthPolicy>;
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator==(
+    const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+    const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    if (detail::IsConstantEvaluated()) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
     return (&lhs == &rhs) ||
            (lhs.GetSize() == rhs.GetSize() &&
-            std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+            detail::ContiguousEqual(lhs.begin(), rhs.begin(), lhs.GetSize()));
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs,
-                       const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator!=(
+    const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+    const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs,
-                      const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
-                                        rhs.end());
+template <typename Type, typename Allocator, typename GrowthPolicy>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator<(
+    const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+    const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    if (detail::IsConstantEvaluated()) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    return detail::ContiguousLess(lhs.begin(), lhs.GetSize(), rhs.begin(),
+                                  rhs.GetSize());
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs,
-                       const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator<=(
+    const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+    const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs > rhs);
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs,
-                      const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator>(
+    const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+    const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return rhs < lhs;
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs,
-                       const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator>=(
+    const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+    const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs < rhs);
 }
 
+// Удаляет из вектора все элементы, удовлетворяющие pred, за один проход.
+// Возвращает количество удалённых элементов
+template <typename Type, typename Allocator, typename GrowthPolicy,
+          typename Predicate>
+size_t EraseIf(SimpleVector<Type, Allocator, GrowthPolicy>& vector,
+               Predicate pred) {
+    auto new_end = std::remove_if(vector.begin(), vector.end(), pred);
+    const size_t removed = vector.end() - new_end;
+    vector.Erase(new_end, vector.end());
+
+    return removed;
+}
+
+// Переносит элементы vector в std::vector с аллокатором alloc. Буфер
+// std::vector нельзя передать без копирования при любых аллокаторах, поэтому
+// элементы перемещаются по одному. vector очищается с сохранением вместимости
+template <typename Type, typename Allocator, typename GrowthPolicy,
+          typename StdAllocator = std::allocator<Type>>
+std::vector<Type, StdAllocator> ToStdVector(SimpleVector<Type, Allocator, GrowthPolicy>&& vector,
+                                            const StdAllocator& alloc = StdAllocator()) {
+    std::vector<Type, StdAllocator> result(alloc);
+    result.reserve(vector.GetSize());
+    result.insert(result.end(), std::make_move_iterator(vector.begin()),
+                  std::make_move_iterator(vector.end()));
+    vector.Clear();
+    return result;
+}
+
+// Переносит элементы std::vector в новый SimpleVector с аллокатором alloc.
+// Память выделяется один раз, тривиально копируемые элементы копируются
+// побайтово. source очищается
+template <typename GrowthPolicy = DoublingGrowth, typename Type, typename StdAllocator,
+          typename Allocator = std::allocator<Type>>
+SimpleVector<Type, Allocator, GrowthPolicy> FromStdVector(
+    std::vector<Type, StdAllocator>&& source, const Allocator& alloc = Allocator()) {
+    SimpleVector<Type, Allocator, GrowthPolicy> result(ReserveProxyObj(source.size()), alloc);
+    Type* first = source.data();
+    Type* last = first + source.size();
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        result.Append(first, last);
+    } else {
+        result.Append(std::make_move_iterator(first), std::make_move_iterator(last));
+    }
+    source.clear();
+    return result;
+}
+
 ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
-}
\ No newline at end of file
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "simd_compare.h"
+
+namespace detail {
+
+template <typename Container, typename Type, typename = void>
+struct IsViewableContainer : std::false_type {};
+
+// Контейнер хранит элементы подряд и сообщает о них через Data() и GetSize(),
+// как SimpleVector, SmallSimpleVector и MappedSimpleVector
+template <typename Container, typename Type>
+struct IsViewableContainer<
+    Container, Type,
+    std::void_t<decltype(std::declval<Container&>().Data()),
+                decltype(std::declval<Container&>().GetSize())>>
+    : std::is_convertible<
+          std::remove_pointer_t<decltype(std::declval<Container&>().Data())> (*)[],
+          Type (*)[]> {};
+
+}  // namespace detail
+
+// Невладеющее представление непрерывного массива: указатель и длина.
+// SimpleVectorView<const Type> только читает элементы, SimpleVectorView<Type>
+// позволяет их изменять. Представление не продлевает жизнь памяти и становится
+// недействительным при перевыделении буфера вектора
+template <typename Type>
+class SimpleVectorView {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using ValueType = std::remove_cv_t<Type>;
+
+    SimpleVectorView() noexcept = default;
+
+    SimpleVectorView(Type* data, size_t size) noexcept
+        : data_(data), size_(size) {
+    }
+
+    SimpleVectorView(Type* first, Type* last) noexcept
+        : data_(first), size_(last - first) {
+        assert(first <= last);
+    }
+
+    // Создаёт представление всех элементов контейнера с методами Data() и
+    // GetSize(). Представление константного контейнера должно быть константным
+    template <typename Container,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::remove_cv_t<Container>, SimpleVectorView> &&
+                  detail::IsViewableContainer<Container, Type>::value>>
+    SimpleVectorView(Container& container) noexcept
+        : data_(container.Data()), size_(container.GetSize()) {
+    }
+
+    // Изменяемое представление преобразуется в константное
+    template <typename Other,
+              typename = std::enable_if_t<std::is_convertible_v<Other (*)[], Type (*)[]>>>
+    SimpleVectorView(const SimpleVectorView<Other>& other) noexcept
+        : data_(other.Data()), size_(other.GetSize()) {
+    }
+
+    Type* Data() const noexcept { return data_; }
+
+    size_t GetSize() const noexcept { return size_; }
+
+    bool IsEmpty() const noexcept { return size_ == 0; }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+
+        return data_[index];
+    }
+
+    // Возвращает представление count элементов начиная с offset. count
+    // ограничивается концом массива.
+    // Выбрасывает исключение std::out_of_range, если offset > size
+    SimpleVectorView Subview(size_t offset, size_t count = kAll) const {
+        if (offset > size_) {
+            throw std::out_of_range("Subview offset is out of range");
+        }
+
+        return SimpleVectorView(data_ + offset, std::min(count, size_ - offset));
+    }
+
+    // Возвращает первые count элементов. count не должен превышать размер
+    SimpleVectorView First(size_t count) const noexcept {
+        assert(count <= size_);
+        return SimpleVectorView(data_, count);
+    }
+
+    // Возвращает последние count элементов. count не должен превышать размер
+    SimpleVectorView Last(size_t count) const noexcept {
+        assert(count <= size_);
+        return SimpleVectorView(data_ + size_ - count, count);
+    }
+
+    // Итераторная область
+    Iterator begin() const noexcept { return data_; }
+
+    Iterator end() const noexcept { return data_ + size_; }
+
+    ConstIterator cbegin() const noexcept { return data_; }
+
+    ConstIterator cend() const noexcept { return data_ + size_; }
+
+    // Значение count по умолчанию для Subview: до конца массива
+    static constexpr size_t kAll = static_cast<size_t>(-1);
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Container>
+SimpleVectorView(Container&)
+    -> SimpleVectorView<std::remove_pointer_t<decltype(std::declval<Container&>().Data())>>;
+
+template <typename Lhs, typename Rhs,
+          typename = std::enable_if_t<std::is_same_v<std::remove_cv_t<Lhs>,
+                                                     std::remove_cv_t<Rhs>>>>
+bool operator==(const SimpleVectorView<Lhs>& lhs, const SimpleVectorView<Rhs>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() &&
+           detail::ContiguousEqual<std::remove_cv_t<Lhs>>(lhs.Data(), rhs.Data(),
+                                                          lhs.GetSize());
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const SimpleVectorView<Lhs>& lhs, const SimpleVectorView<Rhs>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Lhs, typename Rhs,
+          typename = std::enable_if_t<std::is_same_v<std::remove_cv_t<Lhs>,
+                                                     std::remove_cv_t<Rhs>>>>
+bool operator<(const SimpleVectorView<Lhs>& lhs, const SimpleVectorView<Rhs>& rhs) {
+    return detail::ContiguousLess<std::remove_cv_t<Lhs>>(lhs.Data(), lhs.GetSize(),
+                                                         rhs.Data(), rhs.GetSize());
+}
+
+template <typename Lhs, typename Rhs>
+bool operator<=(const SimpleVectorView<Lhs>& lhs, const SimpleVectorView<Rhs>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Lhs, typename Rhs>
+bool operator>(const SimpleVectorView<Lhs>& lhs, const SimpleVectorView<Rhs>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Lhs, typename Rhs>
+bool operator>=(const SimpleVectorView<Lhs>& lhs, const SimpleVectorView<Rhs>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,579 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "aligned_allocator.h"
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "simd_compare.h"
+#include "uninitialized_memory.h"
+
+// Вектор с тем же интерфейсом, что и SimpleVector, хранящий до N элементов
+// прямо в объекте. Куча используется, только когда элементы перестают
+// помещаться во встроенный буфер. Вернуться во встроенный буфер вектор может
+// только при ShrinkToFit, Clear(true) или автоматическом уменьшении буфера
+template <typename Type, size_t N, typename Allocator = std::allocator<Type>,
+          typename GrowthPolicy = DoublingGrowth>
+class SmallSimpleVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(N > 0, "Inline capacity must be positive");
+    static_assert(std::is_same_v<typename AllocTraits::value_type, Type>,
+                  "Allocator::value_type must be the same as Type");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+    using GrowthPolicyType = GrowthPolicy;
+
+    static constexpr size_t kInlineCapacity = N;
+    // Выравнивание встроенного буфера и буфера в куче
+    static constexpr size_t kAlignment = detail::kAllocatorAlignment<Allocator>;
+
+    SmallSimpleVector() noexcept(noexcept(Allocator())) = default;
+
+    explicit SmallSimpleVector(const Allocator& alloc) noexcept : heap_(alloc) {}
+
+    // Создаёт вектор из size элементов, инициализированных значением по
+    // умолчанию
+    explicit SmallSimpleVector(size_t size, const Allocator& alloc = Allocator())
+        : heap_(alloc) {
+        Reserve(size);
+        detail::UninitializedValueConstruct(Alloc(), Data(), size);
+        size_ = size;
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SmallSimpleVector(size_t size, const Type& value,
+                      const Allocator& alloc = Allocator())
+        : heap_(alloc) {
+        Reserve(size);
+        detail::UninitializedFill(Alloc(), Data(), size, value);
+        size_ = size;
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SmallSimpleVector(std::initializer_list<Type> init,
+                      const Allocator& alloc = Allocator())
+        : heap_(alloc) {
+        Reserve(init.size());
+        detail::UninitializedCopy(Alloc(), init.begin(), init.end(), Data());
+        size_ = init.size();
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other)
+        : SmallSimpleVector(other, AllocTraits::select_on_container_copy_construction(
+                                       other.heap_.GetAllocator())) {
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other, const Allocator& alloc)
+        : heap_(alloc) {
+        Reserve(other.size_);
+        detail::UninitializedCopy(Alloc(), other.begin(), other.end(), Data());
+        size_ = other.size_;
+    }
+
+    // Конструктор перемещения. Буфер в куче забирается целиком, элементы из
+    // встроенного буфера перемещаются по одному
+    SmallSimpleVector(SmallSimpleVector&& moved) noexcept(
+        std::is_nothrow_move_constructible_v<Type>)
+        : heap_(moved.heap_.GetAllocator()) {
+        if (moved.IsInline()) {
+            detail::Relocate(Alloc(), moved.begin(), moved.end(), Data());
+            size_ = std::exchange(moved.size_, 0);
+        } else {
+            heap_ = std::move(moved.heap_);
+            size_ = std::exchange(moved.size_, 0);
+        }
+    }
+
+    ~SmallSimpleVector() {
+        Clear();
+    }
+
+    // Аллокатор при присваивании не распространяется
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs) {
+        if (this != &rhs) {
+            SmallSimpleVector temp(rhs, Alloc());
+            *this = std::move(temp);
+        }
+
+        return *this;
+    }
+
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) {
+        if (this != &rhs) {
+            Clear();
+            if (!rhs.IsInline() && Alloc() == rhs.Alloc()) {
+                heap_ = std::move(rhs.heap_);
+                size_ = std::exchange(rhs.size_, 0);
+            } else {
+                Reserve(rhs.size_);
+                detail::Relocate(Alloc(), rhs.begin(), rhs.end(), Data());
+                size_ = std::exchange(rhs.size_, 0);
+            }
+        }
+
+        return *this;
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вместимость согласно GrowthPolicy
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Создаёт элемент из args прямо в конце вектора, без временного объекта.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            ReallocateAndEmplace(size_, std::forward<Args>(args)...);
+        } else {
+            AllocTraits::construct(Alloc(), end(), std::forward<Args>(args)...);
+        }
+        ++size_;
+
+        return *(end() - 1);
+    }
+
+    // Создаёт элемент из args прямо в позиции pos, сдвигая хвост вправо.
+    // Возвращает итератор на созданный элемент. При вставке в середину
+    // заполненного не до конца вектора элемент сначала создаётся во временном
+    // объекте, так как args могут ссылаться на элементы вектора
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        size_t index = pos - begin();
+
+        if (size_ == GetCapacity()) {
+            ReallocateAndEmplace(index, std::forward<Args>(args)...);
+        } else if (index == size_) {
+            AllocTraits::construct(Alloc(), end(), std::forward<Args>(args)...);
+        } else {
+            Type value(std::forward<Args>(args)...);
+            detail::InsertShifted(Alloc(), begin() + index, end(), std::move(value));
+        }
+        ++size_;
+
+        return begin() + index;
+    }
+
+    // Вставляет элементы [first, last) в позицию pos.
+    // Возвращает итератор на первый вставленный элемент.
+    // Для forward-итераторов итоговый размер вычисляется заранее: память
+    // перевыделяется не более одного раза, а хвост сдвигается один раз.
+    // Input-итераторы дописываются в конец и переставляются на место.
+    // Итераторы не должны указывать внутрь вектора
+    template <typename InputIt>
+    Iterator InsertRange(ConstIterator pos, InputIt first, InputIt last) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = pos - begin();
+
+        if constexpr (detail::kIsForwardIterator<InputIt>) {
+            const size_t count = std::distance(first, last);
+            if (count == 0) {
+                return begin() + index;
+            }
+
+            if (count > GetCapacity() - size_) {
+                if (count > GetMaxSize() - size_) {
+                    throw std::length_error("SmallSimpleVector capacity exceeds max size");
+                }
+                ArrayPtr<Type, Allocator> new_heap(GrowCapacity(size_ + count),
+                                                   Alloc());
+                Type* new_data = new_heap.Get();
+                detail::UninitializedCopy(Alloc(), first, last, new_data + index);
+                try {
+                    detail::RelocateWithGap(Alloc(), begin(), end(), new_data,
+                                            index, count);
+                } catch (...) {
+                    detail::Destroy(Alloc(), new_data + index,
+                                    new_data + index + count);
+                    throw;
+                }
+                heap_ = std::move(new_heap);
+            } else {
+                detail::InsertRangeShifted(Alloc(), begin() + index, end(), first,
+                                           last, count);
+            }
+            size_ += count;
+        } else {
+            const size_t old_size = size_;
+            try {
+                for (; first != last; ++first) {
+                    EmplaceBack(*first);
+                }
+            } catch (...) {
+                detail::Destroy(Alloc(), begin() + old_size, end());
+                size_ = old_size;
+                throw;
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+
+        return begin() + index;
+    }
+
+    // Дописывает элементы [first, last) в конец вектора
+    template <typename InputIt>
+    void Append(InputIt first, InputIt last) {
+        InsertRange(end(), first, last);
+    }
+
+    // Заменяет содержимое вектора элементами [first, last).
+    // Итераторы не должны указывать внутрь вектора
+    template <typename InputIt>
+    void Assign(InputIt first, InputIt last) {
+        if constexpr (detail::kIsForwardIterator<InputIt>) {
+            const size_t count = std::distance(first, last);
+            if (count > GetCapacity()) {
+                ArrayPtr<Type, Allocator> new_heap(CheckCapacity(count), Alloc());
+                detail::UninitializedCopy(Alloc(), first, last, new_heap.Get());
+                Clear();
+                heap_ = std::move(new_heap);
+            } else if (count <= size_) {
+                Iterator new_end = std::copy(first, last, begin());
+                detail::Destroy(Alloc(), new_end, end());
+            } else {
+                InputIt mid = std::next(first, size_);
+                std::copy(first, mid, begin());
+                detail::UninitializedCopy(Alloc(), mid, last, end());
+            }
+            size_ = count;
+        } else {
+            Clear();
+            Append(first, last);
+        }
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        AllocTraits::destroy(Alloc(), Data() + size_);
+        AutoShrink();
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+
+        size_t index = pos - begin();
+        detail::EraseShifted(Alloc(), begin() + index, end());
+        --size_;
+        AutoShrink();
+
+        return begin() + index;
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост один раз.
+    // Возвращает итератор на элемент, следовавший за удалёнными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        Type* data = Data();
+        detail::EraseRangeShifted(Alloc(), data + index, data + index + count,
+                                  data + size_);
+        size_ -= count;
+        AutoShrink();
+
+        return begin() + index;
+    }
+
+    // Резервирует место. Повышает Capacity
+    // Выбрасывает исключение std::length_error, если new_capacity > GetMaxSize()
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate(CheckCapacity(new_capacity));
+        }
+    }
+
+    // Уменьшает вместимость до размера вектора. Если элементы помещаются во
+    // встроенный буфер, они переносятся в него, а память в куче освобождается
+    void ShrinkToFit() {
+        ShrinkTo(size_);
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SmallSimpleVector& other) {
+        if (!IsInline() && !other.IsInline()) {
+            std::swap(size_, other.size_);
+            heap_.swap(other.heap_);
+            return;
+        }
+
+        SmallSimpleVector temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    // Возвращает копию аллокатора вектора
+    Allocator GetAllocator() const noexcept { return heap_.GetAllocator(); }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept { return size_; }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept { return IsInline() ? N : heap_.GetSize(); }
+
+    // Возвращает наибольшую вместимость, которую допускает аллокатор
+    size_t GetMaxSize() const noexcept {
+        return AllocTraits::max_size(heap_.GetAllocator());
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept { return size_ == 0; }
+
+    // Сообщает, хранятся ли элементы во встроенном буфере
+    bool IsInline() const noexcept { return !heap_; }
+
+    // Возвращает указатель на первый элемент, выровненный хотя бы по
+    // kAlignment байт
+    Type* Data() noexcept {
+        return IsInline() ? reinterpret_cast<Type*>(inline_) : heap_.Get();
+    }
+
+    const Type* Data() const noexcept {
+        return IsInline() ? reinterpret_cast<const Type*>(inline_) : heap_.Get();
+    }
+
+    // Сообщает, выровнен ли буфер по границе alignment байт. alignment должен
+    // быть степенью двойки
+    bool IsAligned(size_t alignment) const noexcept {
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        return (reinterpret_cast<std::uintptr_t>(Data()) & (alignment - 1)) == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+
+        return Data()[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+
+        return Data()[index];
+    }
+
+    // Разрушает все элементы. Если release_memory равен true, буфер в куче
+    // освобождается и вектор возвращается ко встроенному буферу
+    void Clear(bool release_memory = false) noexcept {
+        detail::Destroy(Alloc(), begin(), end());
+        size_ = 0;
+        if (release_memory) {
+            ArrayPtr<Type, Allocator> released(std::move(heap_));
+        }
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для
+    // типа Type
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            detail::Destroy(Alloc(), begin() + new_size, end());
+            size_ = new_size;
+            AutoShrink();
+            return;
+        }
+
+        if (new_size > GetCapacity()) {
+            Reallocate(GrowCapacity(new_size));
+        }
+
+        detail::UninitializedValueConstruct(Alloc(), end(), new_size - size_);
+        size_ = new_size;
+    }
+
+    // Итераторная область
+    Iterator begin() noexcept { return Data(); }
+
+    Iterator end() noexcept { return Data() + size_; }
+
+    ConstIterator begin() const noexcept { return Data(); }
+
+    ConstIterator end() const noexcept { return Data() + size_; }
+
+    ConstIterator cbegin() const noexcept { return Data(); }
+
+    ConstIterator cend() const noexcept { return Data() + size_; }
+
+private:
+    Allocator& Alloc() noexcept { return heap_.GetAllocator(); }
+
+    // Переносит элементы в буфер в куче вместимостью new_capacity
+    void Reallocate(size_t new_capacity) {
+        ArrayPtr<Type, Allocator> new_heap(new_capacity, Alloc());
+        detail::Relocate(Alloc(), begin(), end(), new_heap.Get());
+        heap_ = std::move(new_heap);
+    }
+
+    // Уменьшает вместимость до new_capacity, не меньшей размера вектора.
+    // Вместимость встроенного буфера не уменьшается
+    void ShrinkTo(size_t new_capacity) {
+        assert(new_capacity >= size_);
+        if (IsInline() || new_capacity >= GetCapacity()) {
+            return;
+        }
+
+        if (new_capacity <= N) {
+            Type* inline_data = reinterpret_cast<Type*>(inline_);
+            detail::Relocate(Alloc(), heap_.Get(), heap_.Get() + size_, inline_data);
+            ArrayPtr<Type, Allocator> released(std::move(heap_));
+        } else {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Уменьшает буфер, если этого требует GrowthPolicy. Уменьшение делается по
+    // возможности: если перевыделение не удалось, вектор остаётся прежним
+    void AutoShrink() noexcept {
+        if constexpr (detail::kHasShrinkCapacity<GrowthPolicy>) {
+            if (IsInline()) {
+                return;
+            }
+            const size_t new_capacity = std::max(
+                GrowthPolicy::ShrinkCapacity(size_, GetCapacity()), size_);
+            if (new_capacity < GetCapacity()) {
+                try {
+                    ShrinkTo(new_capacity);
+                } catch (...) {
+                }
+            }
+        }
+    }
+
+    // Переносит элементы в новый буфер вместимостью, выбранной GrowthPolicy,
+    // и создаёт в нём элемент из args в позиции index. Новый элемент создаётся
+    // первым: args могут ссылаться на элементы старого буфера. Размер вектора
+    // не меняется
+    template <typename... Args>
+    void ReallocateAndEmplace(size_t index, Args&&... args) {
+        ArrayPtr<Type, Allocator> new_heap(GrowCapacity(size_ + 1), Alloc());
+        Type* new_data = new_heap.Get();
+        AllocTraits::construct(Alloc(), new_data + index,
+                               std::forward<Args>(args)...);
+        try {
+            detail::RelocateWithGap(Alloc(), begin(), end(), new_data, index);
+        } catch (...) {
+            AllocTraits::destroy(Alloc(), new_data + index);
+            throw;
+        }
+        heap_ = std::move(new_heap);
+    }
+
+    size_t CheckCapacity(size_t capacity) const {
+        if (capacity > GetMaxSize()) {
+            throw std::length_error("SmallSimpleVector capacity exceeds max size");
+        }
+
+        return capacity;
+    }
+
+    // Возвращает вместимость, выбранную GrowthPolicy, для хранения хотя бы
+    // required элементов
+    size_t GrowCapacity(size_t required) const {
+        return GrowthPolicy::NextCapacity(GetCapacity(), CheckCapacity(required),
+                                          GetMaxSize(), sizeof(Type));
+    }
+
+    ArrayPtr<Type, Allocator> heap_;
+    size_t size_ = 0;
+    alignas(kAlignment) unsigned char inline_[N * sizeof(Type)];
+};
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator==(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs,
+                       const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return (&lhs == &rhs) ||
+           (lhs.GetSize() == rhs.GetSize() &&
+            detail::ContiguousEqual(lhs.begin(), rhs.begin(), lhs.GetSize()));
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator!=(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs,
+                       const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator<(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs,
+                      const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return detail::ContiguousLess(lhs.begin(), lhs.GetSize(), rhs.begin(),
+                                  rhs.GetSize());
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator<=(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs,
+                       const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator>(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs,
+                      const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool operator>=(const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& lhs,
+                       const SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
+
+// Удаляет из вектора все элементы, удовлетворяющие pred, за один проход.
+// Возвращает количество удалённых элементов
+template <typename Type, size_t N, typename Allocator, typename GrowthPolicy,
+          typename Predicate>
+size_t EraseIf(SmallSimpleVector<Type, N, Allocator, GrowthPolicy>& vector,
+               Predicate pred) {
+    auto new_end = std::remove_if(vector.begin(), vector.end(), pred);
+    const size_t removed = vector.end() - new_end;
+    vector.Erase(new_end, vector.end());
+
+    return removed;
+}
@@ -0,0 +1,541 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "aligned_allocator.h"
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "simple_vector_view.h"
+#include "uninitialized_memory.h"
+
+// Вектор записей из полей Fields..., хранящий каждое поле в отдельном
+// столбце (структура массивов). Цикл, читающий одно поле, проходит только
+// по памяти этого столбца. Столбцы выровнены по кэш-линии, у всех столбцов
+// общие размер и вместимость.
+// operator[] и итераторы возвращают кортеж ссылок на поля записи. Такой
+// итератор подходит для обхода и изменения полей, но не для алгоритмов,
+// переставляющих записи через std::swap
+template <typename... Fields>
+class SoaSimpleVector {
+    static_assert(sizeof...(Fields) > 0, "SoaSimpleVector needs at least one field");
+
+    template <typename Field>
+    using ColumnAllocator = AlignedAllocator<Field>;
+
+    template <typename Field>
+    using ColumnStorage = ArrayPtr<Field, ColumnAllocator<Field>>;
+
+    using Indices = std::index_sequence_for<Fields...>;
+
+    template <bool Const>
+    class BasicIterator;
+
+public:
+    using ValueType = std::tuple<Fields...>;
+    using Reference = std::tuple<Fields&...>;
+    using ConstReference = std::tuple<const Fields&...>;
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, ValueType>;
+
+    SoaSimpleVector() noexcept = default;
+
+    // Создаёт вектор из size записей, поля которых инициализированы значением
+    // по умолчанию
+    explicit SoaSimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    SoaSimpleVector(std::initializer_list<ValueType> init) {
+        Reserve(init.size());
+        for (const ValueType& row : init) {
+            PushBack(row);
+        }
+    }
+
+    // Вместимость копии равна размеру оригинала
+    SoaSimpleVector(const SoaSimpleVector& other)
+        : SoaSimpleVector(ReserveColumns{}, other.size_) {
+        CopyColumns(other, Indices{});
+        size_ = other.size_;
+    }
+
+    SoaSimpleVector(SoaSimpleVector&& other) noexcept
+        : columns_(std::move(other.columns_)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {
+    }
+
+    SoaSimpleVector& operator=(const SoaSimpleVector& rhs) {
+        if (this != &rhs) {
+            SoaSimpleVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SoaSimpleVector& operator=(SoaSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SoaSimpleVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~SoaSimpleVector() {
+        Clear();
+    }
+
+    // Добавляет запись в конец вектора
+    void PushBack(const ValueType& row) {
+        std::apply([this](const Fields&... fields) { EmplaceBack(fields...); }, row);
+    }
+
+    void PushBack(ValueType&& row) {
+        std::apply([this](Fields&... fields) { EmplaceBack(std::move(fields)...); }, row);
+    }
+
+    // Создаёт запись в конце вектора, i-е поле создаётся из i-го аргумента.
+    // Если конструктор поля выбросил исключение, вектор не меняется
+    template <typename... Args>
+    void EmplaceBack(Args&&... fields) {
+        static_assert(sizeof...(Args) == sizeof...(Fields),
+                      "EmplaceBack takes one argument per field");
+        if (size_ == capacity_) {
+            ReallocateAndEmplace(std::forward<Args>(fields)...);
+        } else {
+            ConstructRow(size_, Indices{}, std::forward<Args>(fields)...);
+        }
+        ++size_;
+    }
+
+    // Удаляет последнюю запись. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        DestroyRows(size_, size_ + 1, Indices{});
+    }
+
+    // Резервирует место под new_capacity записей во всех столбцах.
+    // Выбрасывает исключение std::length_error, если new_capacity > GetMaxSize()
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Reallocate(CheckCapacity(new_capacity));
+        }
+    }
+
+    // Изменяет число записей. Новые записи получают значения полей по
+    // умолчанию
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            DestroyRows(new_size, size_, Indices{});
+            size_ = new_size;
+            return;
+        }
+        if (new_size > capacity_) {
+            Reallocate(GrowthPolicy::NextCapacity(capacity_, CheckCapacity(new_size),
+                                                  GetMaxSize(), kRowSize));
+        }
+        ValueConstructRows(size_, new_size, Indices{});
+        size_ = new_size;
+    }
+
+    // Разрушает все записи, вместимость сохраняется
+    void Clear() noexcept {
+        DestroyRows(0, size_, Indices{});
+        size_ = 0;
+    }
+
+    void swap(SoaSimpleVector& other) noexcept {
+        SwapColumns(other, Indices{});
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    size_t GetSize() const noexcept { return size_; }
+
+    size_t GetCapacity() const noexcept { return capacity_; }
+
+    bool IsEmpty() const noexcept { return size_ == 0; }
+
+    // Наибольшее число записей, при котором размер всех столбцов помещается
+    // в size_t
+    static constexpr size_t GetMaxSize() noexcept {
+        return std::numeric_limits<size_t>::max() / kRowSize;
+    }
+
+    // Возвращает представление I-го столбца
+    template <size_t I>
+    SimpleVectorView<FieldType<I>> Column() noexcept {
+        return SimpleVectorView<FieldType<I>>(std::get<I>(columns_).Get(), size_);
+    }
+
+    template <size_t I>
+    SimpleVectorView<const FieldType<I>> Column() const noexcept {
+        return SimpleVectorView<const FieldType<I>>(std::get<I>(columns_).Get(), size_);
+    }
+
+    // Возвращает ссылку на I-е поле записи с индексом index
+    template <size_t I>
+    FieldType<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_).Get()[index];
+    }
+
+    template <size_t I>
+    const FieldType<I>& Get(size_t index) const noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_).Get()[index];
+    }
+
+    // Возвращает кортеж ссылок на поля записи с индексом index
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return RowAt<Reference>(*this, index, Indices{});
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return RowAt<ConstReference>(*this, index, Indices{});
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Итераторная область
+    Iterator begin() noexcept { return Iterator(this, 0); }
+
+    Iterator end() noexcept { return Iterator(this, size_); }
+
+    ConstIterator begin() const noexcept { return ConstIterator(this, 0); }
+
+    ConstIterator end() const noexcept { return ConstIterator(this, size_); }
+
+    ConstIterator cbegin() const noexcept { return begin(); }
+
+    ConstIterator cend() const noexcept { return end(); }
+
+private:
+    using GrowthPolicy = DoublingGrowth;
+
+    static constexpr size_t kRowSize = (sizeof(Fields) + ...);
+
+    struct ReserveColumns {};
+
+    // Выделяет память под capacity записей во всех столбцах
+    SoaSimpleVector(ReserveColumns, size_t capacity)
+        : columns_(ColumnStorage<Fields>(capacity)...), capacity_(capacity) {
+    }
+
+    static size_t CheckCapacity(size_t capacity) {
+        if (capacity > GetMaxSize()) {
+            throw std::length_error("SoaSimpleVector capacity exceeds max size");
+        }
+        return capacity;
+    }
+
+    template <typename Row, typename Self, size_t... I>
+    static Row RowAt(Self& self, size_t index, std::index_sequence<I...>) noexcept {
+        return Row(std::get<I>(self.columns_).Get()[index]...);
+    }
+
+    template <size_t I, typename... Args>
+    void ConstructField(size_t index, Args&&... args) {
+        auto& column = std::get<I>(columns_);
+        std::allocator_traits<ColumnAllocator<FieldType<I>>>::construct(
+            column.GetAllocator(), column.Get() + index, std::forward<Args>(args)...);
+    }
+
+    // Разрушает поля [0, count) записи index
+    template <size_t... I>
+    void DestroyFieldPrefix(size_t index, size_t count, std::index_sequence<I...>) noexcept {
+        ((I < count ? detail::Destroy(std::get<I>(columns_).GetAllocator(),
+                                      std::get<I>(columns_).Get() + index,
+                                      std::get<I>(columns_).Get() + index + 1)
+                    : void()),
+         ...);
+    }
+
+    // Создаёт поля записи index по одному. При исключении разрушает уже
+    // созданные поля этой записи
+    template <size_t... I, typename... Args>
+    void ConstructRow(size_t index, std::index_sequence<I...> indices, Args&&... fields) {
+        size_t constructed = 0;
+        try {
+            ((ConstructField<I>(index, std::forward<Args>(fields)), ++constructed), ...);
+        } catch (...) {
+            DestroyFieldPrefix(index, constructed, indices);
+            throw;
+        }
+    }
+
+    // Создаёт записи [first, last) со значениями полей по умолчанию
+    template <size_t... I>
+    void ValueConstructRows(size_t first, size_t last, std::index_sequence<I...> indices) {
+        size_t current = first;
+        try {
+            for (; current != last; ++current) {
+                ConstructRow(current, indices, FieldType<I>()...);
+            }
+        } catch (...) {
+            DestroyRows(first, current, indices);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void DestroyRows(size_t first, size_t last, std::index_sequence<I...>) noexcept {
+        (detail::Destroy(std::get<I>(columns_).GetAllocator(),
+                         std::get<I>(columns_).Get() + first,
+                         std::get<I>(columns_).Get() + last),
+         ...);
+    }
+
+    // Копирует записи other в неинициализированные столбцы этого вектора.
+    // При исключении разрушает уже скопированные столбцы
+    template <size_t... I>
+    void CopyColumns(const SoaSimpleVector& other, std::index_sequence<I...>) {
+        size_t copied = 0;
+        try {
+            (((void)detail::UninitializedCopy(std::get<I>(columns_).GetAllocator(),
+                                              std::get<I>(other.columns_).Get(),
+                                              std::get<I>(other.columns_).Get() + other.size_,
+                                              std::get<I>(columns_).Get()),
+              ++copied),
+             ...);
+        } catch (...) {
+            DestroyCopiedColumns(copied, other.size_, Indices{});
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void DestroyCopiedColumns(size_t count, size_t rows, std::index_sequence<I...>) noexcept {
+        ((I < count ? detail::Destroy(std::get<I>(columns_).GetAllocator(),
+                                      std::get<I>(columns_).Get(),
+                                      std::get<I>(columns_).Get() + rows)
+                    : void()),
+         ...);
+    }
+
+    // Переносит все столбцы в новые буферы вместимостью new_capacity. Если
+    // перемещение хотя бы одного поля может выбросить исключение, копируемые
+    // столбцы копируются: исключение при переносе любого столбца оставляет
+    // вектор прежним
+    void Reallocate(size_t new_capacity) {
+        SoaSimpleVector temp(ReserveColumns{}, new_capacity);
+        temp.RelocateColumns(*this, Indices{});
+        temp.size_ = size_;
+        swap(temp);
+    }
+
+    // Переносит столбцы в новые буферы вместимостью, выбранной GrowthPolicy,
+    // и создаёт в них запись из fields в позиции size_. Запись создаётся
+    // первой: fields могут ссылаться на поля старых столбцов. Размер вектора
+    // не меняется
+    template <typename... Args>
+    void ReallocateAndEmplace(Args&&... fields) {
+        SoaSimpleVector temp(ReserveColumns{},
+                             GrowthPolicy::NextCapacity(capacity_, CheckCapacity(size_ + 1),
+                                                        GetMaxSize(), kRowSize));
+        temp.ConstructRow(size_, Indices{}, std::forward<Args>(fields)...);
+        try {
+            temp.RelocateColumns(*this, Indices{});
+        } catch (...) {
+            temp.DestroyRows(size_, size_ + 1, Indices{});
+            throw;
+        }
+        temp.size_ = size_;
+        swap(temp);
+    }
+
+    static constexpr bool kMoveColumns = (std::is_nothrow_move_constructible_v<Fields> && ...);
+
+    template <size_t I>
+    void RelocateColumn(SoaSimpleVector& other) {
+        auto& column = std::get<I>(columns_);
+        FieldType<I>* first = std::get<I>(other.columns_).Get();
+        if constexpr (kMoveColumns ||
+                      !std::is_copy_constructible_v<FieldType<I>>) {
+            detail::UninitializedMove(column.GetAllocator(), first, first + other.size_,
+                                      column.Get());
+        } else {
+            detail::UninitializedCopy(column.GetAllocator(), first, first + other.size_,
+                                      column.Get());
+        }
+    }
+
+    template <size_t... I>
+    void RelocateColumns(SoaSimpleVector& other, std::index_sequence<I...>) {
+        size_t moved = 0;
+        try {
+            ((RelocateColumn<I>(other), ++moved), ...);
+        } catch (...) {
+            DestroyCopiedColumns(moved, other.size_, Indices{});
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void SwapColumns(SoaSimpleVector& other, std::index_sequence<I...>) noexcept {
+        (std::get<I>(columns_).swap(std::get<I>(other.columns_)), ...);
+    }
+
+    std::tuple<ColumnStorage<Fields>...> columns_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+// Итератор произвольного доступа по записям. Разыменование возвращает кортеж
+// ссылок на поля
+template <typename... Fields>
+template <bool Const>
+class SoaSimpleVector<Fields...>::BasicIterator {
+    using Owner = std::conditional_t<Const, const SoaSimpleVector, SoaSimpleVector>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, ConstReference, Reference>;
+    using pointer = void;
+
+    BasicIterator() noexcept = default;
+
+    BasicIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner), index_(index) {
+    }
+
+    // Изменяющий итератор преобразуется в константный
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+        : owner_(other.owner_), index_(other.index_) {
+    }
+
+    reference operator*() const noexcept { return (*owner_)[index_]; }
+
+    reference operator[](difference_type offset) const noexcept {
+        return (*owner_)[index_ + offset];
+    }
+
+    BasicIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+        BasicIterator copy = *this;
+        ++index_;
+        return copy;
+    }
+
+    BasicIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    BasicIterator operator--(int) noexcept {
+        BasicIterator copy = *this;
+        --index_;
+        return copy;
+    }
+
+    BasicIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    BasicIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const BasicIterator& lhs,
+                                     const BasicIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) -
+               static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ <= rhs.index_;
+    }
+
+    friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ > rhs.index_;
+    }
+
+    friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ >= rhs.index_;
+    }
+
+private:
+    template <bool>
+    friend class BasicIterator;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
+
+template <typename... Fields>
+bool operator==(const SoaSimpleVector<Fields...>& lhs, const SoaSimpleVector<Fields...>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.GetSize(); ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename... Fields>
+bool operator!=(const SoaSimpleVector<Fields...>& lhs, const SoaSimpleVector<Fields...>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,394 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_support.h"
+#include "simd_compare.h"
+#include "uninitialized_memory.h"
+
+namespace detail {
+
+// Наименьший беззнаковый тип, вмещающий числа от 0 до N
+template <size_t N>
+using StaticSizeType = std::conditional_t<
+    N <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+    std::conditional_t<N <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t,
+                       std::conditional_t<N <= std::numeric_limits<std::uint32_t>::max(),
+                                          std::uint32_t, size_t>>>;
+
+}  // namespace detail
+
+// Вектор с тем же интерфейсом, что и SimpleVector, хранящий до N элементов
+// прямо в объекте и никогда не обращающийся к куче. Вместимость известна во
+// время компиляции. Вставка сверх N элементов выбрасывает исключение
+// std::length_error. В C++20 все операции constexpr (см. constexpr_support.h)
+template <typename Type, size_t N>
+class StaticVector {
+    static_assert(N > 0, "StaticVector capacity must be positive");
+
+    // Аллокатор только создаёт и разрушает элементы во встроенном буфере через
+    // вспомогательные функции uninitialized_memory.h и никогда не выделяет
+    // память
+    using ConstructAllocator = std::allocator<Type>;
+    using AllocTraits = std::allocator_traits<ConstructAllocator>;
+    using SizeType = detail::StaticSizeType<N>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    static constexpr size_t kCapacity = N;
+
+    SIMPLE_VECTOR_CONSTEXPR StaticVector() noexcept {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по
+    // умолчанию
+    SIMPLE_VECTOR_CONSTEXPR explicit StaticVector(size_t size) {
+        CheckCapacity(size);
+        detail::UninitializedValueConstruct(Alloc(), Data(), size);
+        size_ = static_cast<SizeType>(size);
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SIMPLE_VECTOR_CONSTEXPR StaticVector(size_t size, const Type& value) {
+        CheckCapacity(size);
+        detail::UninitializedFill(Alloc(), Data(), size, value);
+        size_ = static_cast<SizeType>(size);
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SIMPLE_VECTOR_CONSTEXPR StaticVector(std::initializer_list<Type> init) {
+        CheckCapacity(init.size());
+        detail::UninitializedCopy(Alloc(), init.begin(), init.end(), Data());
+        size_ = static_cast<SizeType>(init.size());
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticVector(const StaticVector& other) {
+        detail::UninitializedCopy(Alloc(), other.begin(), other.end(), Data());
+        size_ = other.size_;
+    }
+
+    // Элементы перемещаются по одному, other остаётся пустым
+    SIMPLE_VECTOR_CONSTEXPR StaticVector(StaticVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<Type>) {
+        detail::Relocate(Alloc(), other.begin(), other.end(), Data());
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ~StaticVector() {
+        Clear();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticVector& operator=(const StaticVector& rhs) {
+        if (this != &rhs) {
+            StaticVector temp(rhs);
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticVector& operator=(StaticVector&& rhs) noexcept(
+        std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            Clear();
+            detail::Relocate(Alloc(), rhs.begin(), rhs.end(), Data());
+            size_ = std::exchange(rhs.size_, 0);
+        }
+
+        return *this;
+    }
+
+    // Добавляет элемент в конец вектора.
+    // Выбрасывает исключение std::length_error, если вектор заполнен
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Создаёт элемент из args прямо в конце вектора.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        CheckCapacity(size_ + size_t{1});
+        AllocTraits::construct(Alloc(), end(), std::forward<Args>(args)...);
+        ++size_;
+
+        return *(end() - 1);
+    }
+
+    // Создаёт элемент из args прямо в позиции pos, сдвигая хвост вправо.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = pos - begin();
+        CheckCapacity(size_ + size_t{1});
+
+        if (index == size_) {
+            AllocTraits::construct(Alloc(), end(), std::forward<Args>(args)...);
+        } else {
+            // args могут ссылаться на элементы вектора
+            Type value(std::forward<Args>(args)...);
+            detail::InsertShifted(Alloc(), begin() + index, end(), std::move(value));
+        }
+        ++size_;
+
+        return begin() + index;
+    }
+
+    // Вставляет элементы [first, last) в позицию pos.
+    // Возвращает итератор на первый вставленный элемент.
+    // Итераторы не должны указывать внутрь вектора
+    template <typename InputIt>
+    SIMPLE_VECTOR_CONSTEXPR Iterator InsertRange(ConstIterator pos, InputIt first,
+                                                 InputIt last) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = pos - begin();
+
+        if constexpr (detail::kIsForwardIterator<InputIt>) {
+            const size_t count = std::distance(first, last);
+            CheckCapacity(size_ + count);
+            detail::InsertRangeShifted(Alloc(), begin() + index, end(), first, last, count);
+            size_ += static_cast<SizeType>(count);
+        } else {
+            const size_t old_size = size_;
+            try {
+                for (; first != last; ++first) {
+                    EmplaceBack(*first);
+                }
+            } catch (...) {
+                detail::Destroy(Alloc(), begin() + old_size, end());
+                size_ = static_cast<SizeType>(old_size);
+                throw;
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+
+        return begin() + index;
+    }
+
+    // Дописывает элементы [first, last) в конец вектора
+    template <typename InputIt>
+    SIMPLE_VECTOR_CONSTEXPR void Append(InputIt first, InputIt last) {
+        InsertRange(end(), first, last);
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        AllocTraits::destroy(Alloc(), end());
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        const size_t index = pos - begin();
+        detail::EraseShifted(Alloc(), begin() + index, end());
+        --size_;
+
+        return begin() + index;
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост один раз.
+    // Возвращает итератор на элемент, следовавший за удалёнными
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        detail::EraseRangeShifted(Alloc(), begin() + index, begin() + index + count, end());
+        size_ -= static_cast<SizeType>(count);
+
+        return begin() + index;
+    }
+
+    // Память не выделяется, метод только проверяет, что new_capacity <= N.
+    // Выбрасывает исключение std::length_error иначе
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
+        CheckCapacity(new_capacity);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit() noexcept {
+    }
+
+    // Обменивает элементы с другим вектором за время, линейное от размеров
+    SIMPLE_VECTOR_CONSTEXPR void swap(StaticVector& other) noexcept(
+        std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_swappable_v<Type>) {
+        StaticVector& longer = size_ >= other.size_ ? *this : other;
+        StaticVector& shorter = size_ >= other.size_ ? other : *this;
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        detail::Relocate(Alloc(), longer.begin() + shorter.size_, longer.end(), shorter.end());
+        std::swap(size_, other.size_);
+    }
+
+    // Возвращает количество элементов в массиве
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept { return size_; }
+
+    // Возвращает вместимость массива
+    static constexpr size_t GetCapacity() noexcept { return N; }
+
+    static constexpr size_t GetMaxSize() noexcept { return N; }
+
+    // Сообщает, пустой ли массив
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept { return size_ == 0; }
+
+    // Сообщает, заполнен ли встроенный буфер
+    SIMPLE_VECTOR_CONSTEXPR bool IsFull() const noexcept { return size_ == N; }
+
+    // Возвращает указатель на первый элемент встроенного буфера
+    SIMPLE_VECTOR_CONSTEXPR Type* Data() noexcept { return storage_.items; }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type* Data() const noexcept { return storage_.items; }
+
+    // Возвращает ссылку на элемент с индексом index
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return storage_.items[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return storage_.items[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+
+        return storage_.items[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Out of range");
+        }
+
+        return storage_.items[index];
+    }
+
+    // Разрушает все элементы
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        detail::Destroy(Alloc(), begin(), end());
+        size_ = 0;
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение по умолчанию.
+    // Выбрасывает исключение std::length_error, если new_size > N
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            detail::Destroy(Alloc(), begin() + new_size, end());
+        } else {
+            CheckCapacity(new_size);
+            detail::UninitializedValueConstruct(Alloc(), end(), new_size - size_);
+        }
+        size_ = static_cast<SizeType>(new_size);
+    }
+
+    // Итераторная область
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept { return Data(); }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept { return Data() + size_; }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept { return Data(); }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept { return Data() + size_; }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept { return Data(); }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept { return Data() + size_; }
+
+private:
+    // Объединение не создаёт элементы массива: их время жизни начинается
+    // с construct и заканчивается destroy
+    union Storage {
+        SIMPLE_VECTOR_CONSTEXPR Storage() noexcept {
+        }
+
+        SIMPLE_VECTOR_CONSTEXPR ~Storage() {
+        }
+
+        Type items[N];
+    };
+
+    SIMPLE_VECTOR_CONSTEXPR ConstructAllocator& Alloc() noexcept { return alloc_; }
+
+    SIMPLE_VECTOR_CONSTEXPR static void CheckCapacity(size_t capacity) {
+        if (capacity > N) {
+            throw std::length_error("StaticVector capacity exceeded");
+        }
+    }
+
+    Storage storage_;
+    SizeType size_ = 0;
+    [[no_unique_address]] ConstructAllocator alloc_;
+};
+
+template <typename Type, size_t N>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator==(const StaticVector<Type, N>& lhs,
+                                               const StaticVector<Type, N>& rhs) {
+    if (detail::IsConstantEvaluated()) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    return (&lhs == &rhs) ||
+           (lhs.GetSize() == rhs.GetSize() &&
+            detail::ContiguousEqual(lhs.begin(), rhs.begin(), lhs.GetSize()));
+}
+
+template <typename Type, size_t N>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator!=(const StaticVector<Type, N>& lhs,
+                                               const StaticVector<Type, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator<(const StaticVector<Type, N>& lhs,
+                                              const StaticVector<Type, N>& rhs) {
+    if (detail::IsConstantEvaluated()) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    return detail::ContiguousLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator<=(const StaticVector<Type, N>& lhs,
+                                               const StaticVector<Type, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator>(const StaticVector<Type, N>& lhs,
+                                              const StaticVector<Type, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator>=(const StaticVector<Type, N>& lhs,
+                                               const StaticVector<Type, N>& rhs) {
+    return !(lhs < rhs);
+}
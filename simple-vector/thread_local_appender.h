@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Накопитель, в который каждый поток добавляет элементы в собственный
+// SimpleVector (шард) без синхронизации с другими потоками. Шард потока
+// создаётся при первом добавлении и находится через thread_local кэш, поэтому
+// обычное добавление не берёт блокировок. MergeInto собирает все шарды в один
+// вектор: резервирует место один раз и переносит шарды параллельно.
+// Кэш помнит один накопитель на поток: поток, попеременно пишущий в несколько
+// накопителей одного типа, берёт блокировку при каждой смене накопителя.
+// MergeInto, GetSize и разрушение требуют, чтобы другие потоки не добавляли
+// элементы
+template <typename Type, typename Allocator = std::allocator<Type>,
+          typename GrowthPolicy = DoublingGrowth>
+class ThreadLocalAppender {
+public:
+    using VectorType = SimpleVector<Type, Allocator, GrowthPolicy>;
+
+    explicit ThreadLocalAppender(const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
+    }
+
+    ThreadLocalAppender(const ThreadLocalAppender&) = delete;
+    ThreadLocalAppender& operator=(const ThreadLocalAppender&) = delete;
+
+    // Возвращает шард текущего потока
+    VectorType& Local() {
+        LocalCache& cache = GetLocalCache();
+        if (cache.owner_id != id_) {
+            cache.shard = &FindOrCreateShard();
+            cache.owner_id = id_;
+        }
+        return *cache.shard;
+    }
+
+    void PushBack(const Type& item) {
+        Local().PushBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        Local().PushBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return Local().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Возвращает общее число элементов во всех шардах
+    size_t GetSize() const {
+        std::lock_guard guard(mutex_);
+        size_t size = 0;
+        for (const std::unique_ptr<Shard>& shard : shards_) {
+            size += shard->items.GetSize();
+        }
+        return size;
+    }
+
+    size_t GetShardCount() const {
+        std::lock_guard guard(mutex_);
+        return shards_.GetSize();
+    }
+
+    // Переносит элементы всех шардов в конец target (см.
+    // SimpleVector::AppendMoved). Элементы одного шарда сохраняют порядок
+    // добавления, шарды идут в порядке их создания. Шарды сохраняют
+    // вместимость для следующего цикла накопления
+    void MergeInto(VectorType& target, const ParallelPolicy& policy = ParallelPolicy()) {
+        std::lock_guard guard(mutex_);
+        SimpleVector<VectorType*> sources;
+        sources.Reserve(shards_.GetSize());
+        for (const std::unique_ptr<Shard>& shard : shards_) {
+            sources.PushBack(&shard->items);
+        }
+        target.AppendMoved(policy, sources.begin(), sources.GetSize());
+    }
+
+    // Собирает элементы всех шардов в новый вектор
+    VectorType Merge(const ParallelPolicy& policy = ParallelPolicy()) {
+        VectorType result(alloc_);
+        MergeInto(result, policy);
+        return result;
+    }
+
+private:
+    // Шарды разных потоков лежат на разных кэш-линиях
+    struct alignas(64) Shard {
+        Shard(std::thread::id owner, const Allocator& alloc)
+            : owner(owner), items(alloc) {
+        }
+
+        std::thread::id owner;
+        VectorType items;
+    };
+
+    // Идентификаторы накопителей не повторяются, поэтому кэш, оставшийся от
+    // разрушенного накопителя, не совпадёт с новым, даже по тому же адресу
+    struct LocalCache {
+        uint64_t owner_id = 0;
+        VectorType* shard = nullptr;
+    };
+
+    static LocalCache& GetLocalCache() noexcept {
+        thread_local LocalCache cache;
+        return cache;
+    }
+
+    VectorType& FindOrCreateShard() {
+        const std::thread::id self = std::this_thread::get_id();
+        std::lock_guard guard(mutex_);
+        for (const std::unique_ptr<Shard>& shard : shards_) {
+            if (shard->owner == self) {
+                return shard->items;
+            }
+        }
+        shards_.PushBack(std::make_unique<Shard>(self, alloc_));
+        return shards_[shards_.GetSize() - 1]->items;
+    }
+
+    inline static std::atomic<uint64_t> next_id_{1};
+
+    const uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+    Allocator alloc_;
+    mutable std::mutex mutex_;
+    SimpleVector<std::unique_ptr<Shard>> shards_;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+// Сообщает, можно ли переносить объекты типа Type побайтовым копированием:
+// перенос объекта memcpy с последующим отказом от вызова деструктора исходного
+// объекта должен быть эквивалентен перемещению и разрушению.
+// По умолчанию верно для тривиально копируемых типов. Пользовательские типы,
+// например обёртки над указателями, могут включить быстрый путь явной
+// специализацией:
+//
+//     template <>
+//     struct IsTriviallyRelocatable<MyHandle> : std::true_type {};
+template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
+template <typename Type, typename Deleter>
+struct IsTriviallyRelocatable<std::unique_ptr<Type, Deleter>>
+    : IsTriviallyRelocatable<Deleter> {};
+
+template <typename Type>
+struct IsTriviallyRelocatable<std::shared_ptr<Type>> : std::true_type {};
+
+template <typename Type>
+inline constexpr bool kIsTriviallyRelocatable = IsTriviallyRelocatable<Type>::value;
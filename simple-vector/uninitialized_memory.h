@@ -0,0 +1,357 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_support.h"
+#include "trivially_relocatable.h"
+
+// Вспомогательные функции для работы с неинициализированной памятью через
+// аллокатор. При исключении каждая функция разрушает уже созданные элементы.
+// Для тривиально переносимых типов (см. IsTriviallyRelocatable) функции
+// переноса копируют байты целиком, не вызывая construct и destroy аллокатора.
+// В константных выражениях (см. constexpr_support.h) побайтовый путь
+// пропускается, и элементы переносятся по одному
+namespace detail {
+
+template <typename It>
+inline constexpr bool kIsForwardIterator =
+    std::is_base_of_v<std::forward_iterator_tag,
+                      typename std::iterator_traits<It>::iterator_category>;
+
+// Побайтово копирует count объектов. Области не должны пересекаться
+template <typename Type>
+void CopyBytes(Type* dest, const Type* src, size_t count) noexcept {
+    if (count != 0) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src),
+                    count * sizeof(Type));
+    }
+}
+
+// Побайтово переносит count объектов. Области могут пересекаться
+template <typename Type>
+void MoveBytes(Type* dest, const Type* src, size_t count) noexcept {
+    if (count != 0) {
+        std::memmove(static_cast<void*>(dest), static_cast<const void*>(src),
+                     count * sizeof(Type));
+    }
+}
+
+// Разрушает элементы [first, last)
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void Destroy(Allocator& alloc, Type* first, Type* last) noexcept {
+    for (; first != last; ++first) {
+        std::allocator_traits<Allocator>::destroy(alloc, first);
+    }
+}
+
+// Копировать можно побайтово, если источник — указатель на тот же
+// тривиально копируемый тип
+template <typename InputIt, typename Type>
+inline constexpr bool kIsBytewiseCopy =
+    std::is_trivially_copyable_v<Type> && std::is_pointer_v<InputIt> &&
+    std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, Type>;
+
+// Создаёт в dest копии элементов [first, last).
+// Возвращает указатель за последним созданным элементом
+template <typename Allocator, typename InputIt, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedCopy(Allocator& alloc, InputIt first,
+                                                InputIt last, Type* dest) {
+    if constexpr (kIsBytewiseCopy<InputIt, Type>) {
+        if (!IsConstantEvaluated()) {
+            CopyBytes(dest, first, last - first);
+            return dest + (last - first);
+        }
+    }
+
+    Type* current = dest;
+    try {
+        for (; first != last; ++first, ++current) {
+            std::allocator_traits<Allocator>::construct(alloc, current, *first);
+        }
+    } catch (...) {
+        Destroy(alloc, dest, current);
+        throw;
+    }
+
+    return current;
+}
+
+// Перемещает элементы [first, last) в неинициализированную память dest
+template <typename Allocator, typename InputIt, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedMove(Allocator& alloc, InputIt first,
+                                                InputIt last, Type* dest) {
+    if constexpr (kIsBytewiseCopy<InputIt, Type>) {
+        return UninitializedCopy(alloc, first, last, dest);
+    }
+    return UninitializedCopy(alloc, std::make_move_iterator(first),
+                             std::make_move_iterator(last), dest);
+}
+
+// Переносить элементы перемещением можно, если оно не бросает исключений
+// или если копирование невозможно. Иначе элементы копируются, и при
+// исключении исходная последовательность остаётся нетронутой
+template <typename Type>
+inline constexpr bool kMoveOnRelocate =
+    std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>;
+
+// Перемещает элементы [first, last) в dest по правилам std::move_if_noexcept
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedMoveIfNoexcept(Allocator& alloc, Type* first,
+                                                          Type* last, Type* dest) {
+    if constexpr (kMoveOnRelocate<Type>) {
+        return UninitializedMove(alloc, first, last, dest);
+    } else {
+        return UninitializedCopy(alloc, first, last, dest);
+    }
+}
+
+// Перемещает по правилам std::move_if_noexcept элементы [first, last) в dest,
+// оставляя свободными gap_size позиций начиная с gap_index: элементы до
+// пропуска ложатся в начало dest, остальные сдвигаются вправо на gap_size
+// позиций
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedMoveWithGap(Allocator& alloc, Type* first,
+                                                      Type* last, Type* dest,
+                                                      size_t gap_index,
+                                                      size_t gap_size = 1) {
+    Type* gap = first + gap_index;
+    UninitializedMoveIfNoexcept(alloc, first, gap, dest);
+    try {
+        UninitializedMoveIfNoexcept(alloc, gap, last, dest + gap_index + gap_size);
+    } catch (...) {
+        Destroy(alloc, dest, dest + gap_index);
+        throw;
+    }
+}
+
+// Переносит элементы [first, last) в неинициализированную память dest.
+// После успешного переноса исходные элементы разрушены. Если Type можно
+// скопировать, а перемещение может бросить исключение, элементы копируются:
+// при исключении исходные элементы остаются нетронутыми
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* Relocate(Allocator& alloc, Type* first, Type* last,
+                                       Type* dest) {
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        if (!IsConstantEvaluated()) {
+            CopyBytes(dest, first, last - first);
+            return dest + (last - first);
+        }
+    }
+    Type* result = UninitializedMoveIfNoexcept(alloc, first, last, dest);
+    Destroy(alloc, first, last);
+    return result;
+}
+
+// То же, что Relocate, но оставляет в dest gap_size свободных позиций
+// начиная с gap_index
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void RelocateWithGap(Allocator& alloc, Type* first, Type* last,
+                                             Type* dest, size_t gap_index,
+                                             size_t gap_size = 1) {
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        if (!IsConstantEvaluated()) {
+            CopyBytes(dest, first, gap_index);
+            CopyBytes(dest + gap_index + gap_size, first + gap_index,
+                      last - first - gap_index);
+            return;
+        }
+    }
+    UninitializedMoveWithGap(alloc, first, last, dest, gap_index, gap_size);
+    Destroy(alloc, first, last);
+}
+
+// Вставляет value в позицию pos последовательности [pos, last), сдвигая
+// хвост на один элемент вправо. За last должна быть свободная память под один
+// элемент
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void InsertShifted(Allocator& alloc, Type* pos, Type* last,
+                                           Type&& value) {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        if (!IsConstantEvaluated()) {
+            MoveBytes(pos + 1, pos, last - pos);
+            try {
+                AllocTraits::construct(alloc, pos, std::move(value));
+            } catch (...) {
+                MoveBytes(pos, pos + 1, last - pos);
+                throw;
+            }
+            return;
+        }
+    }
+    if (pos == last) {
+        AllocTraits::construct(alloc, last, std::move(value));
+    } else {
+        AllocTraits::construct(alloc, last, std::move(*(last - 1)));
+        std::move_backward(pos, last - 1, last);
+        *pos = std::move(value);
+    }
+}
+
+// Вставляет value перед позицией pos последовательности [first, pos),
+// сдвигая её на один элемент влево. Перед first должна быть свободная память
+// под один элемент. value оказывается в позиции pos - 1
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void InsertShiftedFront(Allocator& alloc, Type* first, Type* pos,
+                                                Type&& value) {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        if (!IsConstantEvaluated()) {
+            MoveBytes(first - 1, first, pos - first);
+            try {
+                AllocTraits::construct(alloc, pos - 1, std::move(value));
+            } catch (...) {
+                MoveBytes(first, first - 1, pos - first);
+                throw;
+            }
+            return;
+        }
+    }
+    if (first == pos) {
+        AllocTraits::construct(alloc, first - 1, std::move(value));
+    } else {
+        AllocTraits::construct(alloc, first - 1, std::move(*first));
+        std::move(first + 1, pos, first);
+        *(pos - 1) = std::move(value);
+    }
+}
+
+// Вставляет count элементов [src_first, src_last) в позицию pos
+// последовательности [pos, last), сдвигая хвост вправо один раз. За last должна
+// быть свободная память под count элементов. Источник не должен указывать
+// внутрь сдвигаемой последовательности
+template <typename Allocator, typename Type, typename ForwardIt>
+SIMPLE_VECTOR_CONSTEXPR void InsertRangeShifted(Allocator& alloc, Type* pos, Type* last,
+                        ForwardIt src_first, ForwardIt src_last, size_t count) {
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        if (!IsConstantEvaluated()) {
+            MoveBytes(pos + count, pos, last - pos);
+            try {
+                UninitializedCopy(alloc, src_first, src_last, pos);
+            } catch (...) {
+                MoveBytes(pos, pos + count, last - pos);
+                throw;
+            }
+            return;
+        }
+    }
+    const size_t elements_after = last - pos;
+    if (elements_after > count) {
+        UninitializedMove(alloc, last - count, last, last);
+        try {
+            std::move_backward(pos, last - count, last);
+            std::copy(src_first, src_last, pos);
+        } catch (...) {
+            Destroy(alloc, last, last + count);
+            throw;
+        }
+    } else {
+        ForwardIt src_mid = std::next(src_first, elements_after);
+        Type* moved_to = UninitializedCopy(alloc, src_mid, src_last, last);
+        try {
+            UninitializedMove(alloc, pos, last, moved_to);
+        } catch (...) {
+            Destroy(alloc, last, moved_to);
+            throw;
+        }
+        try {
+            std::copy(src_first, src_mid, pos);
+        } catch (...) {
+            Destroy(alloc, last, moved_to + elements_after);
+            throw;
+        }
+    }
+}
+
+// Удаляет элемент в позиции pos последовательности [pos, last), сдвигая хвост
+// на один элемент влево. Последний элемент оказывается разрушен
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void EraseShifted(Allocator& alloc, Type* pos, Type* last) {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        if (!IsConstantEvaluated()) {
+            AllocTraits::destroy(alloc, pos);
+            MoveBytes(pos, pos + 1, last - pos - 1);
+            return;
+        }
+    }
+    std::move(pos + 1, last, pos);
+    AllocTraits::destroy(alloc, last - 1);
+}
+
+// Удаляет элементы [first, last) последовательности [first, end), сдвигая
+// хвост влево за один проход. Освободившиеся в конце элементы разрушены
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void EraseRangeShifted(Allocator& alloc, Type* first, Type* last,
+                                               Type* end) {
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        if (!IsConstantEvaluated()) {
+            Destroy(alloc, first, last);
+            MoveBytes(first, last, end - last);
+            return;
+        }
+    }
+    Type* new_end = std::move(last, end, first);
+    Destroy(alloc, new_end, end);
+}
+
+// Удаляет элементы [erase_first, erase_last), сдвигая начало [first,
+// erase_first) вправо. Освободившиеся в начале элементы разрушены
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void EraseRangeShiftedFront(Allocator& alloc, Type* first,
+                                                    Type* erase_first, Type* erase_last) {
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        if (!IsConstantEvaluated()) {
+            Destroy(alloc, erase_first, erase_last);
+            MoveBytes(first + (erase_last - erase_first), first, erase_first - first);
+            return;
+        }
+    }
+    Type* new_first = std::move_backward(first, erase_first, erase_last);
+    Destroy(alloc, first, new_first);
+}
+
+// Создаёт в dest count копий value
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedFill(Allocator& alloc, Type* dest,
+                                                size_t count, const Type& value) {
+    Type* current = dest;
+    try {
+        for (Type* last = dest + count; current != last; ++current) {
+            std::allocator_traits<Allocator>::construct(alloc, current, value);
+        }
+    } catch (...) {
+        Destroy(alloc, dest, current);
+        throw;
+    }
+
+    return current;
+}
+
+// Создаёт в dest count элементов, инициализированных значением по умолчанию
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedValueConstruct(Allocator& alloc, Type* dest,
+                                                          size_t count) {
+    Type* current = dest;
+    try {
+        for (Type* last = dest + count; current != last; ++current) {
+            std::allocator_traits<Allocator>::construct(alloc, current);
+        }
+    } catch (...) {
+        Destroy(alloc, dest, current);
+        throw;
+    }
+
+    return current;
+}
+
+}  // namespace detail
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+// Двоичный формат файла с элементами тривиально копируемого типа:
+// заголовок SimpleVectorFileHeader, затем, начиная со смещения data_offset,
+// count элементов подряд. Числа записываются в порядке байт машины, которая
+// сохранила файл. Тип элементов в файле не записан: проверяются только размер
+// и выравнивание
+struct SimpleVectorFileHeader {
+    static constexpr char kMagic[8] = {'S', 'M', 'P', 'L', 'V', 'E', 'C', '\0'};
+    static constexpr uint32_t kVersion = 2;
+    // Данные начинаются с границы кэш-линии
+    static constexpr uint64_t kDataAlignment = 64;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t element_size;
+    uint64_t element_alignment;
+    uint64_t count;
+    uint64_t data_offset;
+    // Контрольная сумма данных (см. detail::FileChecksum)
+    uint64_t checksum;
+};
+
+namespace detail {
+
+// Быстрая некриптографическая контрольная сумма: FNV-1a по 8-байтным словам
+// с побайтовой обработкой хвоста. Умножение переносит изменения только в
+// старшие биты, поэтому перед ним старшая половина суммы складывается с
+// младшей: иначе искажение старших битов слов почти не влияло бы на сумму
+inline uint64_t FileChecksum(const void* data, size_t size) noexcept {
+    constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+    constexpr uint64_t kPrime = 1099511628211ull;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = kOffsetBasis;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash ^= word;
+        hash ^= hash >> 32;
+        hash *= kPrime;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * kPrime;
+    }
+    return hash;
+}
+
+template <typename Type>
+SimpleVectorFileHeader MakeFileHeader(const Type* data, size_t count) noexcept {
+    SimpleVectorFileHeader header{};
+    std::memcpy(header.magic, SimpleVectorFileHeader::kMagic, sizeof(header.magic));
+    header.version = SimpleVectorFileHeader::kVersion;
+    header.element_size = sizeof(Type);
+    header.element_alignment = alignof(Type);
+    header.count = count;
+    const uint64_t alignment =
+        std::max<uint64_t>(SimpleVectorFileHeader::kDataAlignment, alignof(Type));
+    header.data_offset = (sizeof(header) + alignment - 1) / alignment * alignment;
+    header.checksum = FileChecksum(data, count * sizeof(Type));
+    return header;
+}
+
+// Проверяет, что заголовок описывает массив элементов Type, помещающийся
+// в файл размером file_size.
+// Выбрасывает исключение std::runtime_error, если это не так
+template <typename Type>
+void ValidateFileHeader(const SimpleVectorFileHeader& header, uint64_t file_size,
+                        const std::string& path) {
+    if (std::memcmp(header.magic, SimpleVectorFileHeader::kMagic,
+                    sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a SimpleVector file");
+    }
+    if (header.version != SimpleVectorFileHeader::kVersion) {
+        throw std::runtime_error(path + " has unsupported version " +
+                                 std::to_string(header.version));
+    }
+    if (header.element_size != sizeof(Type) ||
+        header.element_alignment != alignof(Type)) {
+        throw std::runtime_error(path + " stores elements of a different type");
+    }
+    if (header.data_offset % alignof(Type) != 0 || header.data_offset > file_size ||
+        header.count > (file_size - header.data_offset) / sizeof(Type)) {
+        throw std::runtime_error(path + " is truncated");
+    }
+}
+
+}  // namespace detail
+
+// Записывает count элементов data в файл path в формате SimpleVectorFileHeader.
+// Выбрасывает исключение std::runtime_error при ошибке записи
+template <typename Type>
+void SaveArray(const std::string& path, const Type* data, size_t count) {
+    static_assert(std::is_trivially_copyable_v<Type>,
+                  "Only trivially copyable elements can be saved");
+    const SimpleVectorFileHeader header = detail::MakeFileHeader(data, count);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    static const char kPadding[SimpleVectorFileHeader::kDataAlignment] = {};
+    for (uint64_t written = sizeof(header); written < header.data_offset;) {
+        const uint64_t chunk =
+            std::min<uint64_t>(header.data_offset - written, sizeof(kPadding));
+        out.write(kPadding, static_cast<std::streamsize>(chunk));
+        written += chunk;
+    }
+    if (count != 0) {
+        out.write(reinterpret_cast<const char*>(data),
+                  static_cast<std::streamsize>(count * sizeof(Type)));
+    }
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+// Записывает элементы вектора в файл path
+// Выбрасывает исключение std::runtime_error при ошибке записи
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void SaveSimpleVector(const std::string& path,
+                      const SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    SaveArray(path, vector.Data(), vector.GetSize());
+}
+
+// Неизменяемый массив элементов, отображённый в память прямо из файла.
+// Открытие файла читает только заголовок: страницы данных загружаются
+// операционной системой при первом обращении к ним
+template <typename Type>
+class MappedSimpleVector {
+    static_assert(std::is_trivially_copyable_v<Type>,
+                  "Only trivially copyable elements can be mapped");
+
+public:
+    using Iterator = const Type*;
+    using ConstIterator = const Type*;
+
+    MappedSimpleVector() noexcept = default;
+
+    // Отображает файл path в память.
+    // Выбрасывает исключение std::runtime_error, если файл не открывается
+    // или не содержит массив элементов Type
+    explicit MappedSimpleVector(const std::string& path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open " + path);
+        }
+
+        struct stat status {};
+        if (fstat(fd, &status) != 0 ||
+            static_cast<uint64_t>(status.st_size) < sizeof(SimpleVectorFileHeader)) {
+            close(fd);
+            throw std::runtime_error(path + " is not a SimpleVector file");
+        }
+        mapped_size_ = static_cast<size_t>(status.st_size);
+        void* mapped = mmap(nullptr, mapped_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            throw std::runtime_error("Failed to map " + path);
+        }
+        mapped_ = static_cast<const unsigned char*>(mapped);
+
+        std::memcpy(&header_, mapped_, sizeof(header_));
+        try {
+            detail::ValidateFileHeader<Type>(header_, mapped_size_, path);
+        } catch (...) {
+            Unmap();
+            throw;
+        }
+    }
+
+    MappedSimpleVector(MappedSimpleVector&& other) noexcept
+        : mapped_(std::exchange(other.mapped_, nullptr)),
+          mapped_size_(std::exchange(other.mapped_size_, 0)),
+          header_(std::exchange(other.header_, SimpleVectorFileHeader{})) {
+    }
+
+    MappedSimpleVector& operator=(MappedSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Unmap();
+            mapped_ = std::exchange(rhs.mapped_, nullptr);
+            mapped_size_ = std::exchange(rhs.mapped_size_, 0);
+            header_ = std::exchange(rhs.header_, SimpleVectorFileHeader{});
+        }
+        return *this;
+    }
+
+    MappedSimpleVector(const MappedSimpleVector&) = delete;
+    MappedSimpleVector& operator=(const MappedSimpleVector&) = delete;
+
+    ~MappedSimpleVector() {
+        Unmap();
+    }
+
+    // Сверяет контрольную сумму данных с заголовком. Читает файл целиком
+    bool Verify() const noexcept {
+        return detail::FileChecksum(Data(), GetSize() * sizeof(Type)) == header_.checksum;
+    }
+
+    const SimpleVectorFileHeader& GetHeader() const noexcept { return header_; }
+
+    const Type* Data() const noexcept {
+        return mapped_ == nullptr
+                   ? nullptr
+                   : reinterpret_cast<const Type*>(mapped_ + header_.data_offset);
+    }
+
+    size_t GetSize() const noexcept { return static_cast<size_t>(header_.count); }
+
+    // Возвращает представление всех элементов файла
+    SimpleVectorView<const Type> View() const noexcept {
+        return SimpleVectorView<const Type>(Data(), GetSize());
+    }
+
+    bool IsEmpty() const noexcept { return GetSize() == 0; }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return Data()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Out of range");
+        }
+
+        return Data()[index];
+    }
+
+    ConstIterator begin() const noexcept { return Data(); }
+
+    ConstIterator end() const noexcept { return Data() + GetSize(); }
+
+    ConstIterator cbegin() const noexcept { return begin(); }
+
+    ConstIterator cend() const noexcept { return end(); }
+
+private:
+    void Unmap() noexcept {
+        if (mapped_ != nullptr) {
+            munmap(const_cast<unsigned char*>(mapped_), mapped_size_);
+            mapped_ = nullptr;
+            mapped_size_ = 0;
+        }
+    }
+
+    const unsigned char* mapped_ = nullptr;
+    size_t mapped_size_ = 0;
+    SimpleVectorFileHeader header_{};
+};
+
+// Загружает файл path в SimpleVector одним копированием памяти.
+// Выбрасывает исключение std::runtime_error, если файл не открывается, не
+// содержит массив элементов Type или его контрольная сумма не совпадает
+template <typename Type, typename Allocator = std::allocator<Type>,
+          typename GrowthPolicy = DoublingGrowth>
+SimpleVector<Type, Allocator, GrowthPolicy> LoadSimpleVector(
+    const std::string& path, const Allocator& alloc = Allocator()) {
+    const MappedSimpleVector<Type> mapped(path);
+    if (!mapped.Verify()) {
+        throw std::runtime_error(path + " is corrupted");
+    }
+    SimpleVector<Type, Allocator, GrowthPolicy> result(alloc);
+    result.Assign(mapped.begin(), mapped.end());
+    return result;
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <typeinfo>
+
+#include "constexpr_support.h"
+
+// Статистика выделений памяти и переносов элементов SimpleVector.
+// Сбор включается макросом SIMPLE_VECTOR_ENABLE_STATS, определённым до
+// подключения simple_vector.h. Без него счётчики не занимают места в векторе,
+// а все обращения к ним компилируются в пустые функции
+struct SimpleVectorStats {
+    // Сколько раз буфер с элементами заменялся новым
+    size_t reallocations = 0;
+    // Сколько байт суммарно запрошено у аллокатора
+    size_t bytes_allocated = 0;
+    // Наибольшая вместимость
+    size_t peak_capacity = 0;
+    // Сколько элементов скопировано и перемещено при вставке, росте и сдвигах.
+    // Побайтовый перенос тривиально переносимых типов считается перемещением
+    size_t elements_copied = 0;
+    size_t elements_moved = 0;
+};
+
+// Счётчики одного типа элементов, общие для всех векторов этого типа
+class TypeStatsNode {
+public:
+    explicit TypeStatsNode(const char* type_name) noexcept
+        : type_name_(type_name) {
+    }
+
+    const char* GetTypeName() const noexcept {
+        return type_name_;
+    }
+
+    SimpleVectorStats Snapshot() const noexcept {
+        SimpleVectorStats stats;
+        stats.reallocations = reallocations_.load(std::memory_order_relaxed);
+        stats.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+        stats.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        stats.elements_copied = elements_copied_.load(std::memory_order_relaxed);
+        stats.elements_moved = elements_moved_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void Reset() noexcept {
+        reallocations_.store(0, std::memory_order_relaxed);
+        bytes_allocated_.store(0, std::memory_order_relaxed);
+        peak_capacity_.store(0, std::memory_order_relaxed);
+        elements_copied_.store(0, std::memory_order_relaxed);
+        elements_moved_.store(0, std::memory_order_relaxed);
+    }
+
+    void OnAllocate(size_t capacity, size_t bytes) noexcept {
+        bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+        size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+        while (peak < capacity &&
+               !peak_capacity_.compare_exchange_weak(peak, capacity,
+                                                     std::memory_order_relaxed)) {
+        }
+    }
+
+    void OnReallocate() noexcept {
+        reallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnCopy(size_t count) noexcept {
+        elements_copied_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void OnMove(size_t count) noexcept {
+        elements_moved_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+    friend class SimpleVectorStatsRegistry;
+
+    const char* type_name_;
+    std::atomic<size_t> reallocations_{0};
+    std::atomic<size_t> bytes_allocated_{0};
+    std::atomic<size_t> peak_capacity_{0};
+    std::atomic<size_t> elements_copied_{0};
+    std::atomic<size_t> elements_moved_{0};
+    TypeStatsNode* next_ = nullptr;
+};
+
+// Глобальный реестр статистики по типам элементов. Тип попадает в реестр при
+// первом выделении памяти вектором с такими элементами
+class SimpleVectorStatsRegistry {
+public:
+    static SimpleVectorStatsRegistry& Instance() noexcept {
+        static SimpleVectorStatsRegistry registry;
+        return registry;
+    }
+
+    // Возвращает счётчики типа Type, регистрируя их при первом обращении
+    template <typename Type>
+    static TypeStatsNode& ForType() noexcept {
+        static TypeStatsNode& node = Instance().Register(typeid(Type).name());
+        return node;
+    }
+
+    // Вызывает fn(type_name, stats) для каждого зарегистрированного типа
+    template <typename Fn>
+    void ForEach(Fn fn) const {
+        for (const TypeStatsNode* node = head_.load(std::memory_order_acquire);
+             node != nullptr; node = node->next_) {
+            fn(node->GetTypeName(), node->Snapshot());
+        }
+    }
+
+    // Обнуляет счётчики всех типов
+    void Reset() noexcept {
+        for (TypeStatsNode* node = head_.load(std::memory_order_acquire);
+             node != nullptr; node = node->next_) {
+            node->Reset();
+        }
+    }
+
+private:
+    SimpleVectorStatsRegistry() = default;
+
+    // Узлы живут до конца программы и добавляются в список без блокировок
+    TypeStatsNode& Register(const char* type_name) noexcept {
+        TypeStatsNode* node = new TypeStatsNode(type_name);
+        node->next_ = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(node->next_, node,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+        return *node;
+    }
+
+    std::atomic<TypeStatsNode*> head_{nullptr};
+};
+
+// Возвращает суммарную статистику всех векторов с элементами типа Type
+template <typename Type>
+SimpleVectorStats GetSimpleVectorTypeStats() noexcept {
+    return SimpleVectorStatsRegistry::ForType<Type>().Snapshot();
+}
+
+namespace detail {
+
+#ifdef SIMPLE_VECTOR_ENABLE_STATS
+
+// Копит статистику одного вектора и дублирует её в реестр типа Type.
+// При вычислении константного выражения реестр не используется
+template <typename Type>
+class VectorStatsRecorder {
+public:
+    SIMPLE_VECTOR_CONSTEXPR SimpleVectorStats Get() const noexcept {
+        return stats_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void OnAllocate(size_t capacity) noexcept {
+        stats_.bytes_allocated += capacity * sizeof(Type);
+        stats_.peak_capacity = std::max(stats_.peak_capacity, capacity);
+        if (!IsConstantEvaluated()) {
+            SimpleVectorStatsRegistry::ForType<Type>().OnAllocate(capacity,
+                                                                  capacity * sizeof(Type));
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void OnReallocate() noexcept {
+        ++stats_.reallocations;
+        if (!IsConstantEvaluated()) {
+            SimpleVectorStatsRegistry::ForType<Type>().OnReallocate();
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void OnCopy(size_t count) noexcept {
+        stats_.elements_copied += count;
+        if (!IsConstantEvaluated()) {
+            SimpleVectorStatsRegistry::ForType<Type>().OnCopy(count);
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void OnMove(size_t count) noexcept {
+        stats_.elements_moved += count;
+        if (!IsConstantEvaluated()) {
+            SimpleVectorStatsRegistry::ForType<Type>().OnMove(count);
+        }
+    }
+
+    // Добавляет статистику временного вектора, чьё содержимое перешло к этому.
+    // Реестр типа уже учёл эти операции
+    SIMPLE_VECTOR_CONSTEXPR void Merge(const VectorStatsRecorder& other) noexcept {
+        stats_.reallocations += other.stats_.reallocations;
+        stats_.bytes_allocated += other.stats_.bytes_allocated;
+        stats_.peak_capacity = std::max(stats_.peak_capacity, other.stats_.peak_capacity);
+        stats_.elements_copied += other.stats_.elements_copied;
+        stats_.elements_moved += other.stats_.elements_moved;
+    }
+
+private:
+    SimpleVectorStats stats_;
+};
+
+#else
+
+template <typename Type>
+class VectorStatsRecorder {
+public:
+    constexpr SimpleVectorStats Get() const noexcept {
+        return {};
+    }
+
+    constexpr void OnAllocate(size_t) noexcept {}
+    constexpr void OnReallocate() noexcept {}
+    constexpr void OnCopy(size_t) noexcept {}
+    constexpr void OnMove(size_t) noexcept {}
+    constexpr void Merge(const VectorStatsRecorder&) noexcept {}
+};
+
+#endif
+
+}  // namespace detail